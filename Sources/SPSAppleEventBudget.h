@@ -0,0 +1,106 @@
+//
+//  SPSAppleEventBudget.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Cocoa/Cocoa.h>
+
+
+@class SPSFakeSafari, SPSFakeProcessTable, SPSApplicationController;
+
+
+/**
+ * The argument of the budgets command of the tool that asks for the built-in scenarios, instead of the path of a property list.
+ */
+#define SPS_BUILTIN_BUDGETS @"builtin"
+
+/**
+ * The keys of a scenario: its name, the replay lines that set it up, the replay lines that are measured, its budget, and optionally its target.
+ */
+#define SPS_BUDGET_NAME_KEY @"name"
+#define SPS_BUDGET_SETUP_KEY @"setup"
+#define SPS_BUDGET_EVENTS_KEY @"events"
+#define SPS_BUDGET_LIMITS_KEY @"budget"
+#define SPS_BUDGET_TARGETS_KEY @"target"
+
+/**
+ * The optional keys of a scenario: the counters that have to change by exactly the given amount while it is measured, the time each of its URLs is given in seconds, the cooldown of the circuit breaker in seconds, and the time each command of the fake Safari takes in seconds, which is 0 by default.
+ */
+#define SPS_BUDGET_EXPECTED_COUNTERS_KEY @"expect"
+#define SPS_BUDGET_REQUEST_BUDGET_KEY @"deadline"
+#define SPS_BUDGET_COOLDOWN_KEY @"cooldown"
+#define SPS_BUDGET_LATENCY_KEY @"latency"
+
+/**
+ * The key in a budget or target of the limit on all Apple Events together. Any other key is the name of an Apple Event, such as "misc/actv".
+ */
+#define SPS_BUDGET_TOTAL_KEY @"total"
+
+
+/**
+ * Checks that scenarios stay within a budget of Apple Events, so that a change that adds a round trip to Safari is caught.
+ *
+ * Each scenario gets a controller of its own, with the default settings, driven against a fake Safari that counts every Apple Event by its class and identifier. The setup lines of a scenario are replayed first, then the events are counted while its other lines are replayed. Once every URL has been dispatched and every command the controller queued has been sent, the counts are held against the budget.
+ *
+ * A budget fails the check when it is exceeded, and so does a counter that did not change as expected, such as circuit_breaker_opens. A target does not: it is the cost that is aimed for, and a scenario above its target is only reported as such.
+ *
+ * The result of every scenario is written to standard output, and the tool exits with status 1 if any scenario went over its budget. The sps-tool target runs the built-in scenarios as its last build phase, so such a change fails the build.
+ */
+@interface SPSAppleEventBudget : NSObject {
+	NSArray *scenarios;
+	NSUInteger scenarioIndex;
+	NSUInteger failedScenarioCount;
+	NSUInteger aboveTargetScenarioCount;
+	SPSFakeSafari *fakeSafari;
+	SPSFakeProcessTable *processTable;
+	SPSApplicationController *controller;
+	NSUInteger remainingEventCount;
+	NSUInteger pendingURLCount;
+	SEL settledSelector;
+	NSTimeInterval requestBudget;
+	NSDictionary *countersAtStart;
+}
+
+/**
+ * Returns scenarios for the common paths: links and activations, with and without a window in the current space. A burst of triggers while Safari has no window yet has to share a single activation and window creation. A link after Safari has quit has to go straight to the launch path. Other scenarios stall the fake Safari, and follow the circuit breaker from closed to open, through a degraded batch and a probe, and back to closed.
+ *
+ * Their budgets are baselines, the costs of today, so that a change that adds a round trip is caught. Where fewer events are intended, the intended cost is the target.
+ */
++ (NSArray *)builtinScenarios;
+
+/**
+ * Reads scenarios from a property list: an array of dictionaries with a name, setup and event lines in the format of a replay file, a budget that maps "total" or Apple Event names to the largest number allowed, and optionally a target in the same form, expected counter changes, a deadline, a cooldown and a latency.
+ *
+ * @return An array of scenarios, or nil if the file could not be read or has a malformed scenario.
+ */
++ (NSArray *)scenariosWithContentsOfFile:(NSString *)path;
+
+/**
+ * Initializes the budget check.
+ *
+ * @param someScenarios Scenarios as returned by builtinScenarios or scenariosWithContentsOfFile:.
+ */
+- (id)initWithScenarios:(NSArray *)someScenarios;
+
+/**
+ * Starts running the scenarios one after another on the main run loop.
+ */
+- (void)start;
+
+@end
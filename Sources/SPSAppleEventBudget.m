@@ -0,0 +1,449 @@
+//
+//  SPSAppleEventBudget.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSAppleEventBudget.h"
+#import "SPSFakeSafari.h"
+#import "SPSFakeProcessTable.h"
+#import "SPSApplicationController.h"
+#import "SPSSafariDriver.h"
+#import "SPSReplayBenchmark.h"
+#import "SPSURLRequest.h"
+#import "SPSMetrics.h"
+
+
+@interface SPSAppleEventBudget ()
+
+/**
+ * Returns a scenario.
+ *
+ * @param target The intended cost, or nil if it is the budget.
+ */
++ (NSDictionary *)scenarioWithName:(NSString *)name setup:(NSArray *)setup events:(NSArray *)events budget:(NSDictionary *)budget target:(NSDictionary *)target;
+
+/**
+ * Returns a budget or target of the given total, and of one of each of the given Apple Events.
+ *
+ * @param firstName The name of an Apple Event, or nil. Followed by more names, ending with nil.
+ */
++ (NSDictionary *)limitsWithTotal:(NSUInteger)total events:(NSString *)firstName, ... NS_REQUIRES_NIL_TERMINATION;
+
+/**
+ * Returns a scenario with a short deadline and cooldown, so that a stalled Safari takes little time, and with the given expected counter changes.
+ *
+ * @param opens, degradedBatches, probes, closes The expected changes of the counters of the circuit breaker.
+ */
++ (NSDictionary *)circuitBreakerScenario:(NSDictionary *)scenario expectingOpens:(NSInteger)opens degradedBatches:(NSInteger)degradedBatches probes:(NSInteger)probes closes:(NSInteger)closes;
+
+/**
+ * Returns the events of the given replay lines, or nil if a line is malformed.
+ */
++ (NSArray *)eventsWithLines:(NSArray *)lines;
+
+/**
+ * Sets up a controller for the next scenario and replays its setup, or exits once all scenarios have run.
+ */
+- (void)runNextScenario;
+
+/**
+ * Replays the given events, starting now, and performs the given selector once the controller has settled.
+ */
+- (void)replayEvents:(NSArray *)events thenPerformSelector:(SEL)selector;
+
+/**
+ * Delivers an event to the controller.
+ */
+- (void)replayEvent:(NSDictionary *)event;
+
+/**
+ * Waits for the commands the controller has queued once every event has been delivered and every URL has been dispatched, and then performs the selector passed to replayEvents:thenPerformSelector:.
+ */
+- (void)settleIfDone;
+
+/**
+ * Returns a description of every limit that the given counts exceed.
+ */
+- (NSArray *)limitsExceededInLimits:(NSDictionary *)limits sentEvents:(NSCountedSet *)sentEvents totalCount:(NSUInteger)totalCount;
+
+/**
+ * Returns a description of every counter that did not change by the expected amount since the scenario started to be measured.
+ */
+- (NSArray *)countersNotChangedAsExpected:(NSDictionary *)expectedChanges;
+
+/**
+ * Starts counting and replays the events of the current scenario.
+ */
+- (void)measureScenario;
+
+/**
+ * Holds the counted events against the budget of the current scenario and moves on to the next one.
+ */
+- (void)finishScenario;
+
+@end
+
+
+@implementation SPSAppleEventBudget
+
++ (NSArray *)builtinScenarios {
+	NSArray *warmSetup = [NSArray arrayWithObject:@"0 url http://example.com/setup"];
+	NSArray *otherSpaceSetup = [NSArray arrayWithObjects:@"0 url http://example.com/setup", @"0.5 space 2", nil];
+	
+	// Activating Safari and handing over the URL. The window the setup left in front is neither raised again nor are its tabs counted again
+	NSDictionary *warmLink = [self scenarioWithName:@"warm link in a space with a window" setup:warmSetup events:[NSArray arrayWithObject:@"0 url http://example.com/"] budget:[self limitsWithTotal:2 events:@"misc/actv", @"GURL/GURL", nil] target:nil];
+	
+	// A burst shares a single batch, so it costs no more than a single link
+	NSArray *burst = [NSArray arrayWithObjects:@"0 url http://example.com/1", @"0 url http://example.com/2", @"0 url http://example.com/3", @"0 url http://example.com/4", @"0 url http://example.com/5", nil];
+	NSDictionary *warmBurst = [self scenarioWithName:@"burst of links in a space with a window" setup:warmSetup events:burst budget:[self limitsWithTotal:2 events:@"misc/actv", @"GURL/GURL", nil] target:nil];
+	
+	// Activating Safari, making a window with the URL and asking which window that is. The window could be told apart without asking
+	NSDictionary *newWindowLink = [self scenarioWithName:@"link in a space without a window" setup:otherSpaceSetup events:[NSArray arrayWithObject:@"0 url http://example.com/"] budget:[self limitsWithTotal:3 events:@"misc/actv", @"core/crel", nil] target:[self limitsWithTotal:2 events:@"misc/actv", @"core/crel", nil]];
+	
+	// The new window is made with the first URL of the burst, so no blank tab is pointed at a URL, and the others are handed over as tabs of that window
+	NSMutableDictionary *newWindowBurstBudget = [[[self limitsWithTotal:4 events:@"misc/actv", @"core/crel", @"GURL/GURL", nil] mutableCopy] autorelease];
+	[newWindowBurstBudget setObject:[NSNumber numberWithUnsignedInteger:0] forKey:@"core/setd"];
+	NSMutableDictionary *newWindowBurst = [[[self scenarioWithName:@"burst of links in a space without a window" setup:otherSpaceSetup events:burst budget:newWindowBurstBudget target:[self limitsWithTotal:3 events:@"misc/actv", @"core/crel", @"GURL/GURL", nil]] mutableCopy] autorelease];
+	[newWindowBurst setObject:[NSDictionary dictionaryWithObject:[NSNumber numberWithInteger:1] forKey:SPSCounterGetName(SPSCounterWindowCreations)] forKey:SPS_BUDGET_EXPECTED_COUNTERS_KEY];
+	
+	// Only activating Safari, since the window is already in front
+	NSDictionary *activation = [self scenarioWithName:@"activation in a space with a window" setup:warmSetup events:[NSArray arrayWithObject:@"0 activate"] budget:[self limitsWithTotal:1 events:@"misc/actv", nil] target:nil];
+	
+	// Activating Safari and making an empty window, which is what is intended
+	NSDictionary *newWindowActivation = [self scenarioWithName:@"activation in a space without a window" setup:otherSpaceSetup events:[NSArray arrayWithObject:@"0 activate"] budget:[self limitsWithTotal:2 events:@"misc/actv", nil] target:nil];
+	
+	// Three timeouts in a row open the breaker, the next batch only hands over its URLs, and once the cooldown has passed a probe that is answered closes the breaker again. Each timeout only costs the raise that stalls
+	NSArray *opening = [NSArray arrayWithObjects:@"0 stall", @"0.1 url http://example.com/1", @"0.5 url http://example.com/2", @"0.9 url http://example.com/3", nil];
+	NSArray *breakerPathEvents = [opening arrayByAddingObjectsFromArray:[NSArray arrayWithObjects:@"1.3 url http://example.com/4", @"1.5 recover", @"2.6 url http://example.com/5", nil]];
+	NSDictionary *breakerPath = [self circuitBreakerScenario:[self scenarioWithName:@"circuit breaker opens, degrades and closes" setup:warmSetup events:breakerPathEvents budget:[self limitsWithTotal:8 events:nil] target:nil] expectingOpens:1 degradedBatches:1 probes:1 closes:1];
+	
+	// Once open, a batch costs nothing but handing over its URLs
+	NSArray *openSetup = [warmSetup arrayByAddingObjectsFromArray:[NSArray arrayWithObjects:@"0.5 stall", @"0.6 url http://example.com/1", @"1.0 url http://example.com/2", @"1.4 url http://example.com/3", nil]];
+	NSDictionary *degradedLink = [self circuitBreakerScenario:[self scenarioWithName:@"link while the circuit breaker is open" setup:openSetup events:[NSArray arrayWithObject:@"0 url http://example.com/"] budget:[self limitsWithTotal:1 events:@"GURL/GURL", nil] target:nil] expectingOpens:0 degradedBatches:1 probes:0 closes:0];
+	
+	// A probe that times out opens the breaker again at once
+	NSDictionary *failedProbe = [self circuitBreakerScenario:[self scenarioWithName:@"probe of a Safari that still stalls" setup:openSetup events:[NSArray arrayWithObject:@"1.2 url http://example.com/"] budget:[self limitsWithTotal:1 events:nil] target:nil] expectingOpens:1 degradedBatches:0 probes:1 closes:0];
+	
+	// URLs whose deadline has passed before they are dispatched send nothing, which says nothing about Safari
+	NSMutableDictionary *expiredLinks = [[[self circuitBreakerScenario:[self scenarioWithName:@"links past their deadline" setup:[NSArray array] events:[NSArray arrayWithObjects:@"0 url http://example.com/1", @"0.3 url http://example.com/2", @"0.6 url http://example.com/3", nil] budget:[self limitsWithTotal:0 events:nil] target:nil] expectingOpens:0 degradedBatches:0 probes:0 closes:0] mutableCopy] autorelease];
+	[expiredLinks setObject:[NSNumber numberWithDouble:0.0] forKey:SPS_BUDGET_REQUEST_BUDGET_KEY];
+	
+	// Activating Safari and a burst of links at once, while Safari takes a while to answer, share one activation and one window. The batch joins the activation, so it asks which window is in front, counts its tabs and hands over the URLs
+	NSArray *coldBurstEvents = [NSArray arrayWithObjects:@"0 activate", @"0 url http://example.com/1", @"0 url http://example.com/2", @"0 url http://example.com/3", nil];
+	NSMutableDictionary *coldBurst = [[[self scenarioWithName:@"activation and burst of links before Safari has a window" setup:[NSArray array] events:coldBurstEvents budget:[self limitsWithTotal:6 events:@"misc/actv", @"core/crel", nil] target:nil] mutableCopy] autorelease];
+	[coldBurst setObject:[NSNumber numberWithDouble:0.05] forKey:SPS_BUDGET_LATENCY_KEY];
+	[coldBurst setObject:[NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithInteger:1], SPSCounterGetName(SPSCounterActivations), [NSNumber numberWithInteger:1], SPSCounterGetName(SPSCounterJoinedActivations), [NSNumber numberWithInteger:1], SPSCounterGetName(SPSCounterWindowCreations), nil] forKey:SPS_BUDGET_EXPECTED_COUNTERS_KEY];
+	
+	// Once Safari has quit, the next link goes straight to the launch path: activating Safari, which launches it, making a window with the URL and asking which window that is. The window that was there before is not raised, and System Events is only asked for windows if another Safari is running on this Mac
+	NSMutableDictionary *relaunchBudget = [[[self limitsWithTotal:4 events:@"misc/actv", @"core/crel", @"core/getd", @"core/cnte", nil] mutableCopy] autorelease];
+	[relaunchBudget setObject:[NSNumber numberWithUnsignedInteger:0] forKey:@"core/setd"];
+	NSMutableDictionary *relaunchLink = [[[self scenarioWithName:@"link after Safari has quit" setup:warmSetup events:[NSArray arrayWithObjects:@"0 quit", @"0.5 url http://example.com/", nil] budget:relaunchBudget target:nil] mutableCopy] autorelease];
+	[relaunchLink setObject:[NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithInteger:1], SPSCounterGetName(SPSCounterSafariExits), [NSNumber numberWithInteger:1], SPSCounterGetName(SPSCounterSafariLaunches), [NSNumber numberWithInteger:1], SPSCounterGetName(SPSCounterWindowCreations), nil] forKey:SPS_BUDGET_EXPECTED_COUNTERS_KEY];
+	
+	return [NSArray arrayWithObjects:warmLink, warmBurst, newWindowLink, newWindowBurst, activation, newWindowActivation, coldBurst, relaunchLink, breakerPath, degradedLink, failedProbe, expiredLinks, nil];
+}
+
++ (NSArray *)scenariosWithContentsOfFile:(NSString *)path {
+	NSArray *fileScenarios = [NSArray arrayWithContentsOfFile:path];
+	if (fileScenarios == nil) {
+		return nil;
+	}
+	
+	for (id scenario in fileScenarios) {
+		if (![scenario isKindOfClass:[NSDictionary class]] || ![[scenario objectForKey:SPS_BUDGET_NAME_KEY] isKindOfClass:[NSString class]] || ![[scenario objectForKey:SPS_BUDGET_LIMITS_KEY] isKindOfClass:[NSDictionary class]]) {
+			return nil;
+		}
+		if ([scenario objectForKey:SPS_BUDGET_TARGETS_KEY] != nil && ![[scenario objectForKey:SPS_BUDGET_TARGETS_KEY] isKindOfClass:[NSDictionary class]]) {
+			return nil;
+		}
+		if ([scenario objectForKey:SPS_BUDGET_EXPECTED_COUNTERS_KEY] != nil && ![[scenario objectForKey:SPS_BUDGET_EXPECTED_COUNTERS_KEY] isKindOfClass:[NSDictionary class]]) {
+			return nil;
+		}
+		if (([scenario objectForKey:SPS_BUDGET_REQUEST_BUDGET_KEY] != nil && ![[scenario objectForKey:SPS_BUDGET_REQUEST_BUDGET_KEY] isKindOfClass:[NSNumber class]]) || ([scenario objectForKey:SPS_BUDGET_COOLDOWN_KEY] != nil && ![[scenario objectForKey:SPS_BUDGET_COOLDOWN_KEY] isKindOfClass:[NSNumber class]]) || ([scenario objectForKey:SPS_BUDGET_LATENCY_KEY] != nil && ![[scenario objectForKey:SPS_BUDGET_LATENCY_KEY] isKindOfClass:[NSNumber class]])) {
+			return nil;
+		}
+		
+		// A scenario without setup starts out with Safari running, but without windows
+		NSArray *setup = [scenario objectForKey:SPS_BUDGET_SETUP_KEY];
+		NSArray *events = [scenario objectForKey:SPS_BUDGET_EVENTS_KEY];
+		if ((setup != nil && (![setup isKindOfClass:[NSArray class]] || [self eventsWithLines:setup] == nil)) || ![events isKindOfClass:[NSArray class]] || [self eventsWithLines:events] == nil) {
+			return nil;
+		}
+	}
+	
+	return fileScenarios;
+}
+
++ (NSDictionary *)scenarioWithName:(NSString *)name setup:(NSArray *)setup events:(NSArray *)events budget:(NSDictionary *)budget target:(NSDictionary *)target {
+	return [NSDictionary dictionaryWithObjectsAndKeys:name, SPS_BUDGET_NAME_KEY, setup, SPS_BUDGET_SETUP_KEY, events, SPS_BUDGET_EVENTS_KEY, budget, SPS_BUDGET_LIMITS_KEY, target, SPS_BUDGET_TARGETS_KEY, nil];
+}
+
++ (NSDictionary *)limitsWithTotal:(NSUInteger)total events:(NSString *)firstName, ... {
+	NSMutableDictionary *limits = [NSMutableDictionary dictionaryWithObject:[NSNumber numberWithUnsignedInteger:total] forKey:SPS_BUDGET_TOTAL_KEY];
+	
+	va_list arguments;
+	va_start(arguments, firstName);
+	for (NSString *name = firstName; name != nil; name = va_arg(arguments, NSString *)) {
+		[limits setObject:[NSNumber numberWithUnsignedInteger:1] forKey:name];
+	}
+	va_end(arguments);
+	
+	return limits;
+}
+
++ (NSDictionary *)circuitBreakerScenario:(NSDictionary *)scenario expectingOpens:(NSInteger)opens degradedBatches:(NSInteger)degradedBatches probes:(NSInteger)probes closes:(NSInteger)closes {
+	NSMutableDictionary *breakerScenario = [[scenario mutableCopy] autorelease];
+	
+	[breakerScenario setObject:[NSNumber numberWithDouble:0.2] forKey:SPS_BUDGET_REQUEST_BUDGET_KEY];
+	[breakerScenario setObject:[NSNumber numberWithDouble:1.0] forKey:SPS_BUDGET_COOLDOWN_KEY];
+	[breakerScenario setObject:[NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithInteger:opens], SPSCounterGetName(SPSCounterCircuitBreakerOpens), [NSNumber numberWithInteger:degradedBatches], SPSCounterGetName(SPSCounterDegradedBatches), [NSNumber numberWithInteger:probes], SPSCounterGetName(SPSCounterCircuitBreakerProbes), [NSNumber numberWithInteger:closes], SPSCounterGetName(SPSCounterCircuitBreakerCloses), nil] forKey:SPS_BUDGET_EXPECTED_COUNTERS_KEY];
+	
+	return breakerScenario;
+}
+
++ (NSArray *)eventsWithLines:(NSArray *)lines {
+	NSMutableArray *events = [NSMutableArray arrayWithCapacity:[lines count]];
+	
+	for (id line in lines) {
+		NSDictionary *event = [line isKindOfClass:[NSString class]] ? [SPSReplayBenchmark eventWithLine:line] : nil;
+		if (event == nil) {
+			return nil;
+		}
+		
+		[events addObject:event];
+	}
+	
+	return events;
+}
+
+- (id)initWithScenarios:(NSArray *)someScenarios {
+	if ((self = [super init])) {
+		scenarios = [someScenarios copy];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[NSObject cancelPreviousPerformRequestsWithTarget:self];
+	[controller release];
+	[scenarios release];
+	[countersAtStart release];
+	[fakeSafari setWindowCreationHandler:nil];
+	[fakeSafari setLaunchHandler:nil];
+	[fakeSafari release];
+	[processTable release];
+	[super dealloc];
+}
+
+- (void)start {
+	scenarioIndex = 0;
+	[self runNextScenario];
+}
+
+#pragma mark SPSAppleEventBudget
+
+- (void)runNextScenario {
+	if (scenarioIndex >= [scenarios count]) {
+		printf("%lu of %lu scenarios over budget, %lu above target\n", (unsigned long)failedScenarioCount, (unsigned long)[scenarios count], (unsigned long)aboveTargetScenarioCount);
+		fflush(stdout);
+		exit((failedScenarioCount > 0) ? 1 : 0);
+	}
+	
+	// Every scenario starts from a running Safari without windows and a controller that has not seen anything yet
+	[controller release];
+	[fakeSafari setWindowCreationHandler:nil];
+	[fakeSafari setLaunchHandler:nil];
+	[fakeSafari release];
+	[processTable release];
+	
+	NSDictionary *scenario = [scenarios objectAtIndex:scenarioIndex];
+	NSNumber *scenarioRequestBudget = [scenario objectForKey:SPS_BUDGET_REQUEST_BUDGET_KEY];
+	requestBudget = (scenarioRequestBudget != nil) ? [scenarioRequestBudget doubleValue] : SPS_URL_REQUEST_BUDGET;
+	
+	SPSControllerSettings settings = SPSDefaultControllerSettings();
+	if ([scenario objectForKey:SPS_BUDGET_COOLDOWN_KEY] != nil) {
+		settings.circuitBreakerCooldown = [[scenario objectForKey:SPS_BUDGET_COOLDOWN_KEY] doubleValue];
+	}
+	
+	fakeSafari = [[SPSFakeSafari alloc] initWithLatency:[[scenario objectForKey:SPS_BUDGET_LATENCY_KEY] doubleValue]];
+	[fakeSafari launch];
+	processTable = [[SPSFakeProcessTable alloc] init];
+	[processTable launchProcessWithIdentifier:[fakeSafari processIdentifier] bundleIdentifier:SAFARI_BUNDLE_IDENTIFIER];
+	controller = [[SPSApplicationController alloc] initWithProcessBackend:processTable windowListSource:fakeSafari scriptingEngine:fakeSafari settings:settings];
+	
+	// Tell the controller about new windows, like the accessibility notification for a real one would
+	__block SPSApplicationController *observingController = controller;
+	[fakeSafari setWindowCreationHandler:^(NSInteger windowIdentifier) {
+		dispatch_async(dispatch_get_main_queue(), ^{
+			[observingController windowObserver:nil didObserveCreationOfWindow:windowIdentifier];
+		});
+	}];
+	
+	// Tell the registry about a Safari that was launched again, like the workspace would
+	__block SPSFakeProcessTable *launchedProcessTable = processTable;
+	[fakeSafari setLaunchHandler:^(pid_t processIdentifier) {
+		dispatch_async(dispatch_get_main_queue(), ^{
+			[launchedProcessTable launchProcessWithIdentifier:processIdentifier bundleIdentifier:SAFARI_BUNDLE_IDENTIFIER];
+		});
+	}];
+	
+	NSArray *setupEvents = [[self class] eventsWithLines:[scenario objectForKey:SPS_BUDGET_SETUP_KEY]];
+	[self replayEvents:setupEvents thenPerformSelector:@selector(measureScenario)];
+}
+
+- (void)replayEvents:(NSArray *)events thenPerformSelector:(SEL)selector {
+	remainingEventCount = [events count];
+	settledSelector = selector;
+	
+	for (NSDictionary *event in events) {
+		[self performSelector:@selector(replayEvent:) withObject:event afterDelay:[[event objectForKey:SPS_EVENT_TIME_KEY] doubleValue]];
+	}
+	
+	[self settleIfDone];
+}
+
+- (void)replayEvent:(NSDictionary *)event {
+	NSString *kind = [event objectForKey:SPS_EVENT_KIND_KEY];
+	NSString *argument = [event objectForKey:SPS_EVENT_ARGUMENT_KEY];
+	
+	if ([kind isEqualToString:SPS_URL_EVENT]) {
+		SPSURLRequest *request = [[SPSURLRequest alloc] initWithURL:[NSURL URLWithString:argument] suspensionID:NULL deadline:[NSDate timeIntervalSinceReferenceDate] + requestBudget];
+		
+		// The controller is let go of before the budget check, so its requests should not retain the check
+		__block SPSAppleEventBudget *budget = self;
+		[request setCompletionHandler:^(SPSURLRequest *completedRequest) {
+			budget->pendingURLCount--;
+			[budget settleIfDone];
+		}];
+		
+		pendingURLCount++;
+		[controller openRequest:request];
+		[request release];
+	}
+	else if ([kind isEqualToString:SPS_ACTIVATE_EVENT]) {
+		[controller applicationWillBecomeActive:nil];
+	}
+	else if ([kind isEqualToString:SPS_SPACE_EVENT]) {
+		[fakeSafari setActiveSpaceIdentifier:[argument integerValue]];
+		[[[NSWorkspace sharedWorkspace] notificationCenter] postNotificationName:NSWorkspaceActiveSpaceDidChangeNotification object:[NSWorkspace sharedWorkspace]];
+	}
+	else if ([kind isEqualToString:SPS_STALL_EVENT] || [kind isEqualToString:SPS_RECOVER_EVENT]) {
+		[fakeSafari setStalled:[kind isEqualToString:SPS_STALL_EVENT]];
+	}
+	else if ([kind isEqualToString:SPS_QUIT_EVENT]) {
+		// The workspace is slow to report the exit, so the controller has to notice it on its own
+		[fakeSafari quit];
+	}
+	
+	remainingEventCount--;
+	[self settleIfDone];
+}
+
+- (void)settleIfDone {
+	if (remainingEventCount > 0 || pendingURLCount > 0 || settledSelector == NULL) {
+		return;
+	}
+	
+	// Activations are not answered like URLs, so wait for what they queued as well
+	SEL selector = settledSelector;
+	settledSelector = NULL;
+	[controller performAfterQueuedCommands:^{
+		[self performSelector:selector];
+	}];
+}
+
+- (void)measureScenario {
+	[fakeSafari resetSentEvents];
+	
+	[countersAtStart release];
+	countersAtStart = [SPSCounterSnapshot() retain];
+	
+	NSArray *events = [[self class] eventsWithLines:[[scenarios objectAtIndex:scenarioIndex] objectForKey:SPS_BUDGET_EVENTS_KEY]];
+	[self replayEvents:events thenPerformSelector:@selector(finishScenario)];
+}
+
+- (void)finishScenario {
+	NSDictionary *scenario = [scenarios objectAtIndex:scenarioIndex];
+	NSDictionary *budget = [scenario objectForKey:SPS_BUDGET_LIMITS_KEY];
+	NSCountedSet *sentEvents = [fakeSafari sentEvents];
+	
+	NSUInteger totalCount = 0;
+	for (NSString *name in sentEvents) {
+		totalCount += [sentEvents countForObject:name];
+	}
+	
+	NSArray *violations = [[self limitsExceededInLimits:budget sentEvents:sentEvents totalCount:totalCount] arrayByAddingObjectsFromArray:[self countersNotChangedAsExpected:[scenario objectForKey:SPS_BUDGET_EXPECTED_COUNTERS_KEY]]];
+	NSArray *missedTargets = [self limitsExceededInLimits:[scenario objectForKey:SPS_BUDGET_TARGETS_KEY] sentEvents:sentEvents totalCount:totalCount];
+	if ([missedTargets count] > 0) {
+		aboveTargetScenarioCount++;
+	}
+	
+	NSMutableArray *counts = [NSMutableArray arrayWithCapacity:[sentEvents count]];
+	for (NSString *name in [[sentEvents allObjects] sortedArrayUsingSelector:@selector(compare:)]) {
+		[counts addObject:[NSString stringWithFormat:@"%@ %lu", name, (unsigned long)[sentEvents countForObject:name]]];
+	}
+	
+	if ([violations count] > 0) {
+		failedScenarioCount++;
+		printf("FAIL %s: %s (%s)\n", [[scenario objectForKey:SPS_BUDGET_NAME_KEY] UTF8String], [[violations componentsJoinedByString:@", "] UTF8String], [[counts componentsJoinedByString:@", "] UTF8String]);
+	}
+	else if ([missedTargets count] > 0) {
+		printf("ok %s: %lu events within the baseline, above target: %s (%s)\n", [[scenario objectForKey:SPS_BUDGET_NAME_KEY] UTF8String], (unsigned long)totalCount, [[missedTargets componentsJoinedByString:@", "] UTF8String], [[counts componentsJoinedByString:@", "] UTF8String]);
+	}
+	else {
+		printf("ok %s: %lu events (%s)\n", [[scenario objectForKey:SPS_BUDGET_NAME_KEY] UTF8String], (unsigned long)totalCount, [[counts componentsJoinedByString:@", "] UTF8String]);
+	}
+	fflush(stdout);
+	
+	scenarioIndex++;
+	[self runNextScenario];
+}
+
+- (NSArray *)limitsExceededInLimits:(NSDictionary *)limits sentEvents:(NSCountedSet *)sentEvents totalCount:(NSUInteger)totalCount {
+	// Name every limit that was exceeded, so that the offending round trip is easy to find
+	NSMutableArray *exceededLimits = [NSMutableArray array];
+	for (NSString *key in [[limits allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+		NSUInteger limit = [[limits objectForKey:key] unsignedIntegerValue];
+		NSUInteger count = [key isEqualToString:SPS_BUDGET_TOTAL_KEY] ? totalCount : [sentEvents countForObject:key];
+		
+		if (count > limit) {
+			[exceededLimits addObject:[NSString stringWithFormat:@"%@ %lu > %lu", key, (unsigned long)count, (unsigned long)limit]];
+		}
+	}
+	
+	return exceededLimits;
+}
+
+- (NSArray *)countersNotChangedAsExpected:(NSDictionary *)expectedChanges {
+	NSDictionary *counters = SPSCounterSnapshot();
+	
+	NSMutableArray *unexpectedChanges = [NSMutableArray array];
+	for (NSString *name in [[expectedChanges allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+		long long expectedChange = [[expectedChanges objectForKey:name] longLongValue];
+		long long change = [[counters objectForKey:name] longLongValue] - [[countersAtStart objectForKey:name] longLongValue];
+		
+		if (change != expectedChange) {
+			[unexpectedChanges addObject:[NSString stringWithFormat:@"%@ changed by %lld, not %lld", name, change, expectedChange]];
+		}
+	}
+	
+	return unexpectedChanges;
+}
+
+@end
@@ -0,0 +1,56 @@
+//
+//  SPSAppleEventEngine.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import "SPSScriptingEngine.h"
+
+
+/**
+ * The time that activating waits for Safari to finish launching when there is no deadline, in seconds, and how often it looks.
+ */
+#define SPS_APPLE_EVENT_LAUNCH_TIMEOUT 60.0
+#define SPS_APPLE_EVENT_LAUNCH_POLL_INTERVAL 0.02
+
+
+/**
+ * A scripting engine that sends raw Apple Events, bypassing ScriptingBridge.
+ *
+ * The events for all commands are built once, as templates. Sending a command only copies its template and patches in the parameters that change, such as a window identifier or a URL.
+ *
+ * Apple Events cannot launch an application, so activating launches Safari through the workspace if it is not running, and waits for it to finish launching within the deadline, like ScriptingBridge does.
+ */
+@interface SPSAppleEventEngine : NSObject <SPSScriptingEngine> {
+	id <SPSScriptingEngineDelegate> delegate;
+	NSTimeInterval deadline;
+	NSAppleEventDescriptor *activateEvent;
+	NSAppleEventDescriptor *raiseWindowEvent;
+	NSAppleEventDescriptor *miniaturizeWindowEvent;
+	NSAppleEventDescriptor *closeWindowEvent;
+	NSAppleEventDescriptor *frontWindowIdentifierEvent;
+	NSAppleEventDescriptor *countTabsEvent;
+	NSAppleEventDescriptor *makeDocumentEvent;
+	NSAppleEventDescriptor *setTabURLEvent;
+	NSAppleEventDescriptor *countProcessWindowsEvent;
+	pid_t countProcessWindowsProcessIdentifier;
+	NSUInteger sentCommandCount;
+}
+
+@end
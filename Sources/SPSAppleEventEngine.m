@@ -0,0 +1,278 @@
+//
+//  SPSAppleEventEngine.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSAppleEventEngine.h"
+#import "SPSSafariDriver.h"
+#import "SPSAppleEvents.h"
+#import "SPSSafariCodes.h"
+#import "SPSSystemEventsCodes.h"
+#import "SPSMetrics.h"
+
+
+/**
+ * Returns a specifier for a Safari window by its identifier.
+ */
+static NSAppleEventDescriptor *SPSWindowSpecifier(NSInteger windowIdentifier) {
+	return SPSObjectSpecifier(SPSSafariWindowClass, nil, formUniqueID, [NSAppleEventDescriptor descriptorWithInt32:(SInt32)windowIdentifier]);
+}
+
+
+@interface SPSAppleEventEngine ()
+
+/**
+ * Returns a new event for Safari with the given class and identifier.
+ */
+- (NSAppleEventDescriptor *)eventForSafariWithClass:(AEEventClass)eventClass identifier:(AEEventID)eventID;
+
+/**
+ * Launches Safari and waits until it has finished launching, but no longer than the deadline.
+ */
+- (void)launchSafari;
+
+/**
+ * Sends a copy of the given template event, with its direct object and other parameters patched in.
+ *
+ * @param template A template event, may not be nil.
+ * @param directObject The direct object to patch in, or nil to keep that of the template.
+ * @param parameters A dictionary of parameter descriptors by NSNumber keyword to patch in, or nil.
+ * @param missCounter The counter of deadline misses for this kind of command.
+ * @return The direct object of the reply, or nil if the event failed.
+ */
+- (NSAppleEventDescriptor *)sendEvent:(NSAppleEventDescriptor *)template directObject:(NSAppleEventDescriptor *)directObject parameters:(NSDictionary *)parameters missCounter:(SPSCounter)missCounter;
+
+@end
+
+
+@implementation SPSAppleEventEngine
+
+- (id)init {
+	if ((self = [super init])) {
+		activateEvent = [[self eventForSafariWithClass:kAEMiscStandards identifier:kAEActivate] retain];
+		
+		raiseWindowEvent = [[self eventForSafariWithClass:kAECoreSuite identifier:kAESetData] retain];
+		[raiseWindowEvent setParamDescriptor:[NSAppleEventDescriptor descriptorWithInt32:1] forKeyword:keyAEData];
+		
+		miniaturizeWindowEvent = [[self eventForSafariWithClass:kAECoreSuite identifier:kAESetData] retain];
+		
+		closeWindowEvent = [[self eventForSafariWithClass:kAECoreSuite identifier:kAEClose] retain];
+		
+		frontWindowIdentifierEvent = [[self eventForSafariWithClass:kAECoreSuite identifier:kAEGetData] retain];
+		NSAppleEventDescriptor *frontWindow = SPSObjectSpecifier(SPSSafariWindowClass, nil, formAbsolutePosition, [NSAppleEventDescriptor descriptorWithInt32:1]);
+		[frontWindowIdentifierEvent setParamDescriptor:SPSPropertySpecifier(pID, frontWindow) forKeyword:keyDirectObject];
+		
+		countTabsEvent = [[self eventForSafariWithClass:kAECoreSuite identifier:kAECountElements] retain];
+		[countTabsEvent setParamDescriptor:[NSAppleEventDescriptor descriptorWithTypeCode:SPSSafariTabClass] forKeyword:keyAEObjectClass];
+		
+		makeDocumentEvent = [[self eventForSafariWithClass:kAECoreSuite identifier:kAECreateElement] retain];
+		[makeDocumentEvent setParamDescriptor:[NSAppleEventDescriptor descriptorWithTypeCode:SPSSafariDocumentClass] forKeyword:keyAEObjectClass];
+		
+		setTabURLEvent = [[self eventForSafariWithClass:kAECoreSuite identifier:kAESetData] retain];
+		
+		// Counting windows goes to System Events, and needs a process specifier that is only built once we know the process
+		NSData *systemEventsBundleIdentifier = [SYSTEM_EVENTS_BUNDLE_IDENTIFIER dataUsingEncoding:NSUTF8StringEncoding];
+		NSAppleEventDescriptor *systemEventsTarget = [NSAppleEventDescriptor descriptorWithDescriptorType:typeApplicationBundleID data:systemEventsBundleIdentifier];
+		countProcessWindowsEvent = [[NSAppleEventDescriptor alloc] initWithEventClass:kAECoreSuite eventID:kAECountElements targetDescriptor:systemEventsTarget returnID:kAutoGenerateReturnID transactionID:kAnyTransactionID];
+		[countProcessWindowsEvent setParamDescriptor:[NSAppleEventDescriptor descriptorWithTypeCode:SPSSystemEventsWindowClass] forKeyword:keyAEObjectClass];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[activateEvent release];
+	[raiseWindowEvent release];
+	[miniaturizeWindowEvent release];
+	[closeWindowEvent release];
+	[frontWindowIdentifierEvent release];
+	[countTabsEvent release];
+	[makeDocumentEvent release];
+	[setTabURLEvent release];
+	[countProcessWindowsEvent release];
+	[super dealloc];
+}
+
+#pragma mark SPSScriptingEngine
+
+- (void)setDelegate:(id <SPSScriptingEngineDelegate>)aDelegate {
+	delegate = aDelegate;
+}
+
+- (void)setDeadline:(NSTimeInterval)aDeadline {
+	deadline = aDeadline;
+}
+
+- (void)activate {
+	// Apple Events cannot launch an application, so launch Safari the ordinary way if it is not running
+	if ([[NSRunningApplication runningApplicationsWithBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER] count] == 0) {
+		[self launchSafari];
+		return;
+	}
+	
+	[self sendEvent:activateEvent directObject:nil parameters:nil missCounter:SPSCounterActivateDeadlineMisses];
+}
+
+- (void)raiseWindow:(NSInteger)windowIdentifier {
+	[self sendEvent:raiseWindowEvent directObject:SPSPropertySpecifier(pIndex, SPSWindowSpecifier(windowIdentifier)) parameters:nil missCounter:SPSCounterRaiseWindowDeadlineMisses];
+}
+
+- (void)setMiniaturized:(BOOL)miniaturized ofWindow:(NSInteger)windowIdentifier {
+	NSDictionary *parameters = [NSDictionary dictionaryWithObject:[NSAppleEventDescriptor descriptorWithBoolean:miniaturized] forKey:[NSNumber numberWithUnsignedInt:keyAEData]];
+	[self sendEvent:miniaturizeWindowEvent directObject:SPSSafariWindowMiniaturizedSpecifier(SPSWindowSpecifier(windowIdentifier)) parameters:parameters missCounter:SPSCounterMiniaturizeDeadlineMisses];
+}
+
+- (void)closeWindow:(NSInteger)windowIdentifier {
+	[self sendEvent:closeWindowEvent directObject:SPSWindowSpecifier(windowIdentifier) parameters:nil missCounter:SPSCounterCloseWindowDeadlineMisses];
+}
+
+- (NSInteger)frontWindowIdentifier {
+	return [[self sendEvent:frontWindowIdentifierEvent directObject:nil parameters:nil missCounter:SPSCounterFrontWindowDeadlineMisses] int32Value];
+}
+
+- (NSUInteger)countOfTabsInWindow:(NSInteger)windowIdentifier {
+	return [[self sendEvent:countTabsEvent directObject:SPSWindowSpecifier(windowIdentifier) parameters:nil missCounter:SPSCounterCountTabsDeadlineMisses] int32Value];
+}
+
+- (void)makeDocumentWithURL:(NSURL *)URL {
+	NSDictionary *parameters = nil;
+	
+	if (URL != nil) {
+		NSAppleEventDescriptor *properties = [NSAppleEventDescriptor recordDescriptor];
+		[properties setDescriptor:[NSAppleEventDescriptor descriptorWithString:[URL absoluteString]] forKeyword:SPSSafariDocumentURLProperty];
+		parameters = [NSDictionary dictionaryWithObject:properties forKey:[NSNumber numberWithUnsignedInt:keyAEPropData]];
+	}
+	
+	[self sendEvent:makeDocumentEvent directObject:nil parameters:parameters missCounter:SPSCounterMakeDocumentDeadlineMisses];
+}
+
+- (void)setURL:(NSURL *)URL ofTab:(NSUInteger)tabIndex inWindow:(NSInteger)windowIdentifier {
+	NSAppleEventDescriptor *tab = SPSObjectSpecifier(SPSSafariTabClass, SPSWindowSpecifier(windowIdentifier), formAbsolutePosition, [NSAppleEventDescriptor descriptorWithInt32:(SInt32)tabIndex]);
+	NSDictionary *parameters = [NSDictionary dictionaryWithObject:[NSAppleEventDescriptor descriptorWithString:[URL absoluteString]] forKey:[NSNumber numberWithUnsignedInt:keyAEData]];
+	
+	[self sendEvent:setTabURLEvent directObject:SPSSafariTabURLSpecifier(tab) parameters:parameters missCounter:SPSCounterSetURLDeadlineMisses];
+}
+
+- (BOOL)openURLs:(NSArray *)URLs {
+	return [[NSWorkspace sharedWorkspace] openURLs:URLs withAppBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER options:NSWorkspaceLaunchDefault additionalEventParamDescriptor:nil launchIdentifiers:NULL];
+}
+
+- (NSUInteger)countOfWindowsOfProcessWithIdentifier:(pid_t)processIdentifier {
+	// The specifier for "first process whose unix id is ..." only changes when the process does
+	if (processIdentifier != countProcessWindowsProcessIdentifier) {
+		NSAppleEventDescriptor *process = SPSFirstElementSpecifier(SPSSystemEventsProcessClass, nil, SPSSystemEventsProcessUnixIdProperty, [NSAppleEventDescriptor descriptorWithInt32:processIdentifier]);
+		[countProcessWindowsEvent setParamDescriptor:process forKeyword:keyDirectObject];
+		countProcessWindowsProcessIdentifier = processIdentifier;
+	}
+	
+	return [[self sendEvent:countProcessWindowsEvent directObject:nil parameters:nil missCounter:SPSCounterCountWindowsDeadlineMisses] int32Value];
+}
+
+- (NSUInteger)sentCommandCount {
+	return sentCommandCount;
+}
+
+- (void)reset {
+	// Events are addressed by bundle identifier, so there is no connection to drop
+}
+
+#pragma mark SPSAppleEventEngine
+
+- (NSAppleEventDescriptor *)eventForSafariWithClass:(AEEventClass)eventClass identifier:(AEEventID)eventID {
+	NSData *safariBundleIdentifier = [SAFARI_BUNDLE_IDENTIFIER dataUsingEncoding:NSUTF8StringEncoding];
+	NSAppleEventDescriptor *safariTarget = [NSAppleEventDescriptor descriptorWithDescriptorType:typeApplicationBundleID data:safariBundleIdentifier];
+	
+	return [[[NSAppleEventDescriptor alloc] initWithEventClass:eventClass eventID:eventID targetDescriptor:safariTarget returnID:kAutoGenerateReturnID transactionID:kAnyTransactionID] autorelease];
+}
+
+- (void)launchSafari {
+	NSTimeInterval startTime = [NSDate timeIntervalSinceReferenceDate];
+	NSTimeInterval launchDeadline = (deadline != 0.0) ? deadline : startTime + SPS_APPLE_EVENT_LAUNCH_TIMEOUT;
+	OSStatus status = noErr;
+	
+	if (startTime >= launchDeadline) {
+		status = errAETimeout;
+	}
+	else {
+		sentCommandCount++;
+		
+		if (![[NSWorkspace sharedWorkspace] launchAppWithBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER options:NSWorkspaceLaunchDefault additionalEventParamDescriptor:nil launchIdentifier:NULL]) {
+			status = procNotFound;
+		}
+		else {
+			// The commands that follow can only be answered once Safari is up. Instances are asked anew, since their properties are only updated on the main run loop
+			while (![[[NSRunningApplication runningApplicationsWithBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER] lastObject] isFinishedLaunching]) {
+				if ([NSDate timeIntervalSinceReferenceDate] >= launchDeadline) {
+					status = errAETimeout;
+					break;
+				}
+				[NSThread sleepForTimeInterval:SPS_APPLE_EVENT_LAUNCH_POLL_INTERVAL];
+			}
+		}
+	}
+	
+	// Launching stands in for the activate event, so it is accounted for like one
+	SPSCounterAdd(SPSCounterAppleEventCommands, 1);
+	int64_t microseconds = (int64_t)(([NSDate timeIntervalSinceReferenceDate] - startTime) * 1000000.0);
+	SPSCounterAdd(SPSCounterAppleEventMicroseconds, microseconds);
+	SPSHistogramRecord(SPSHistogramAppleEventMicroseconds, microseconds);
+	
+	if (status == errAETimeout) {
+		SPSCounterAdd(SPSCounterActivateDeadlineMisses, 1);
+	}
+	if (status != noErr) {
+		[delegate scriptingEngine:self didFailWithError:[NSError errorWithDomain:NSOSStatusErrorDomain code:status userInfo:nil]];
+	}
+}
+
+- (NSAppleEventDescriptor *)sendEvent:(NSAppleEventDescriptor *)template directObject:(NSAppleEventDescriptor *)directObject parameters:(NSDictionary *)parameters missCounter:(SPSCounter)missCounter {
+	NSTimeInterval startTime = [NSDate timeIntervalSinceReferenceDate];
+	
+	// Patch a copy, so that the template stays as it is
+	NSAppleEventDescriptor *event = [[template copy] autorelease];
+	if (directObject != nil) {
+		[event setParamDescriptor:directObject forKeyword:keyDirectObject];
+	}
+	for (NSNumber *keyword in parameters) {
+		[event setParamDescriptor:[parameters objectForKey:keyword] forKeyword:[keyword unsignedIntValue]];
+	}
+	
+	// An event is not sent at all once the deadline has passed
+	if (SPSTimeoutForDeadline(deadline) != 0) {
+		sentCommandCount++;
+	}
+	
+	OSStatus status;
+	NSAppleEventDescriptor *result = SPSSendAppleEvent(event, deadline, &status);
+	
+	SPSCounterAdd(SPSCounterAppleEventCommands, 1);
+	int64_t microseconds = (int64_t)(([NSDate timeIntervalSinceReferenceDate] - startTime) * 1000000.0);
+	SPSCounterAdd(SPSCounterAppleEventMicroseconds, microseconds);
+	SPSHistogramRecord(SPSHistogramAppleEventMicroseconds, microseconds);
+	
+	if (status == errAETimeout) {
+		SPSCounterAdd(missCounter, 1);
+	}
+	if (status != noErr) {
+		[delegate scriptingEngine:self didFailWithError:[NSError errorWithDomain:NSOSStatusErrorDomain code:status userInfo:nil]];
+	}
+	
+	return result;
+}
+
+@end
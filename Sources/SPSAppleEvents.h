@@ -0,0 +1,68 @@
+//
+//  SPSAppleEvents.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#import <Foundation/Foundation.h>
+
+
+/**
+ * Returns an object specifier.
+ *
+ * @param desiredClass The class of the specified object.
+ * @param container The specifier of the containing object, or nil for the application.
+ * @param keyForm How the object is specified, such as formUniqueID.
+ * @param keyData The data for the key form, such as an identifier.
+ */
+NSAppleEventDescriptor *SPSObjectSpecifier(DescType desiredClass, NSAppleEventDescriptor *container, DescType keyForm, NSAppleEventDescriptor *keyData);
+
+/**
+ * Returns a specifier for a property of an object.
+ *
+ * @param property The code of the property.
+ * @param container The specifier of the object, or nil for the application.
+ */
+NSAppleEventDescriptor *SPSPropertySpecifier(DescType property, NSAppleEventDescriptor *container);
+
+/**
+ * Returns a specifier for the first element of the given class whose property equals the given value.
+ *
+ * @param desiredClass The class of the specified object.
+ * @param container The specifier of the containing object, or nil for the application.
+ * @param property The code of the property to compare.
+ * @param value The value to compare the property with.
+ */
+NSAppleEventDescriptor *SPSFirstElementSpecifier(DescType desiredClass, NSAppleEventDescriptor *container, DescType property, NSAppleEventDescriptor *value);
+
+/**
+ * Returns the timeout for an Apple Event that has to be answered by the given deadline.
+ *
+ * @param deadline A time as returned by +[NSDate timeIntervalSinceReferenceDate], or 0 for no deadline.
+ * @return A timeout in ticks, kAEDefaultTimeout if there is no deadline, or 0 if the deadline has passed.
+ */
+long SPSTimeoutForDeadline(NSTimeInterval deadline);
+
+/**
+ * Sends an event and waits for the reply, but no longer than the given deadline.
+ *
+ * @param event The event to send, may not be nil.
+ * @param deadline A time as returned by +[NSDate timeIntervalSinceReferenceDate], or 0 for no deadline. If it has passed, the event is not sent and fails with errAETimeout.
+ * @param status On return, noErr or the error from sending or handling the event. May be NULL.
+ * @return The direct object of the reply, or nil if the event failed or there is none.
+ */
+NSAppleEventDescriptor *SPSSendAppleEvent(NSAppleEventDescriptor *event, NSTimeInterval deadline, OSStatus *status);
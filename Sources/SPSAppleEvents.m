@@ -0,0 +1,86 @@
+//
+//  SPSAppleEvents.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#import "SPSAppleEvents.h"
+
+
+NSAppleEventDescriptor *SPSObjectSpecifier(DescType desiredClass, NSAppleEventDescriptor *container, DescType keyForm, NSAppleEventDescriptor *keyData) {
+	NSAppleEventDescriptor *specifier = [NSAppleEventDescriptor recordDescriptor];
+	
+	[specifier setDescriptor:[NSAppleEventDescriptor descriptorWithTypeCode:desiredClass] forKeyword:keyAEDesiredClass];
+	[specifier setDescriptor:(container != nil) ? container : [NSAppleEventDescriptor nullDescriptor] forKeyword:keyAEContainer];
+	[specifier setDescriptor:[NSAppleEventDescriptor descriptorWithEnumCode:keyForm] forKeyword:keyAEKeyForm];
+	[specifier setDescriptor:keyData forKeyword:keyAEKeyData];
+	
+	return [specifier coerceToDescriptorType:typeObjectSpecifier];
+}
+
+NSAppleEventDescriptor *SPSPropertySpecifier(DescType property, NSAppleEventDescriptor *container) {
+	return SPSObjectSpecifier(cProperty, container, formPropertyID, [NSAppleEventDescriptor descriptorWithTypeCode:property]);
+}
+
+NSAppleEventDescriptor *SPSFirstElementSpecifier(DescType desiredClass, NSAppleEventDescriptor *container, DescType property, NSAppleEventDescriptor *value) {
+	// Build "every element whose property is value", and take the first of those
+	NSAppleEventDescriptor *comparison = [NSAppleEventDescriptor recordDescriptor];
+	NSAppleEventDescriptor *examinedObject = [NSAppleEventDescriptor descriptorWithDescriptorType:typeObjectBeingExamined data:nil];
+	[comparison setDescriptor:[NSAppleEventDescriptor descriptorWithEnumCode:kAEEquals] forKeyword:keyAECompOperator];
+	[comparison setDescriptor:SPSPropertySpecifier(property, examinedObject) forKeyword:keyAEObject1];
+	[comparison setDescriptor:value forKeyword:keyAEObject2];
+	
+	NSAppleEventDescriptor *matchingElements = SPSObjectSpecifier(desiredClass, container, formTest, [comparison coerceToDescriptorType:typeCompDescriptor]);
+	return SPSObjectSpecifier(desiredClass, matchingElements, formAbsolutePosition, [NSAppleEventDescriptor descriptorWithEnumCode:kAEFirst]);
+}
+
+long SPSTimeoutForDeadline(NSTimeInterval deadline) {
+	if (deadline == 0.0) {
+		return kAEDefaultTimeout;
+	}
+	
+	// Round up, so that a little time left does not become no time at all
+	NSTimeInterval remaining = deadline - [NSDate timeIntervalSinceReferenceDate];
+	return (remaining > 0.0) ? (long)ceil(remaining * 60.0) : 0;
+}
+
+NSAppleEventDescriptor *SPSSendAppleEvent(NSAppleEventDescriptor *event, NSTimeInterval deadline, OSStatus *status) {
+	long timeout = SPSTimeoutForDeadline(deadline);
+	if (timeout == 0) {
+		if (status != NULL) {
+			*status = errAETimeout;
+		}
+		return nil;
+	}
+	
+	AppleEvent replyDesc = {typeNull, NULL};
+	OSStatus sendStatus = AESendMessage([event aeDesc], &replyDesc, kAEWaitReply, timeout);
+	NSAppleEventDescriptor *reply = [[[NSAppleEventDescriptor alloc] initWithAEDescNoCopy:&replyDesc] autorelease];
+	
+	// An error may come from sending the event, or from handling it
+	if (sendStatus == noErr) {
+		NSAppleEventDescriptor *errorNumber = [reply paramDescriptorForKeyword:keyErrorNumber];
+		if (errorNumber != nil) {
+			sendStatus = [errorNumber int32Value];
+		}
+	}
+	
+	if (status != NULL) {
+		*status = sendStatus;
+	}
+	return (sendStatus == noErr) ? [reply paramDescriptorForKeyword:keyDirectObject] : nil;
+}
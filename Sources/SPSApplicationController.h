@@ -20,12 +20,116 @@
 //
 
 #import <Cocoa/Cocoa.h>
+#import "SPSWindowObserver.h"
+#import "SPSOpenServer.h"
+#import "SPSDispatcher.h"
+
+
+@protocol SPSProcessBackend, SPSWindowListSource, SPSScriptingEngine;
+@class SPSProcessRegistry, SPSProcessExitWatcher, SPSSpaceWindowIndex, SPSScriptingExecutor, SPSURLRequest, SPSEventRecorder, SPSMetricsServer;
+
+
+/**
+ * The user default that makes Spatial Safari run as a resident agent: without a Dock icon, menu or nib, and started at login.
+ */
+#define SPS_AGENT_MODE_DEFAULT @"AgentMode"
+
+/**
+ * The time from exec until the first event can be handled that a launch should stay within, in seconds.
+ */
+#define SPS_STARTUP_BUDGET 0.1
+
+/**
+ * The user default that makes Spatial Safari launch Safari, hidden, as soon as it starts itself.
+ */
+#define SPS_WARM_UP_DEFAULT @"WarmUpSafari"
+
+/**
+ * The user default that makes Spatial Safari keep a miniaturized blank Safari window ready in spaces without one.
+ */
+#define SPS_WINDOW_POOL_DEFAULT @"WindowPool"
+
+/**
+ * The user defaults key of the scripting engine of the agent: "AppleEvents" for raw Apple Events, or anything else for ScriptingBridge.
+ */
+#define SPS_SCRIPTING_ENGINE_DEFAULT @"ScriptingEngine"
+
+
+/**
+ * The policies of a controller that its backends do not decide. Only the agent takes them from the user defaults, so that harnesses and benchmarks do not depend on the settings of whoever runs them.
+ */
+typedef struct {
+	BOOL usesWindowPool;
+	NSString *eventLogPath;
+	BOOL usesAppleEventEngine;
+	NSUInteger circuitBreakerFailureThreshold;
+	NSTimeInterval circuitBreakerCooldown;
+} SPSControllerSettings;
+
+
+/**
+ * Returns the settings of a controller that pools no windows, records no events, scripts Safari through ScriptingBridge and gives up on it like SPSCircuitBreaker does by default.
+ */
+SPSControllerSettings SPSDefaultControllerSettings(void);
+
+/**
+ * Returns the settings that the user defaults ask for: SPS_WINDOW_POOL_DEFAULT, SPS_RECORD_EVENTS_DEFAULT and SPS_SCRIPTING_ENGINE_DEFAULT.
+ */
+SPSControllerSettings SPSControllerSettingsFromUserDefaults(void);
 
 
 /**
  * Main application controller.
  */
-@interface SPSApplicationController : NSObject <NSApplicationDelegate> {
+@interface SPSApplicationController : NSObject <NSApplicationDelegate, SPSWindowObserverDelegate, SPSOpenServerDelegate, SPSDispatcherDelegate> {
+	SPSProcessRegistry *processRegistry;
+	SPSProcessExitWatcher *safariExitWatcher;
+	SPSSpaceWindowIndex *spaceWindowIndex;
+	SPSWindowObserver *windowObserver;
+	NSMutableDictionary *outstandingRequests;
+	NSMutableDictionary *duplicateRequests;
+	SPSScriptingExecutor *scriptingExecutor;
+	SPSDispatcher *dispatcher;
+	id <SPSWindowListSource> windowListSource;
+	SPSEventRecorder *eventRecorder;
+	NSInteger recordedSpaceIdentifier;
+	SPSMetricsServer *metricsServer;
+	SPSOpenServer *openServer;
+	SPSURLRequest *firstRequest;
+	NSTimeInterval firstRequestTime;
+	BOOL firstRequestFoundSafariRunning;
+	BOOL measuredFirstRequest;
 }
 
+/**
+ * Initializes the controller with the workspace, the window server and the scripting engine chosen by the given settings. The plain initializer, which is for the agent, passes the settings of the user defaults.
+ */
+- (id)initWithSettings:(SPSControllerSettings)settings;
+
+/**
+ * Initializes the controller with the given backends and settings.
+ *
+ * @param processBackend A process backend, may not be nil.
+ * @param windowListSource A window list source, may not be nil.
+ * @param scriptingEngine A scripting engine, may not be nil.
+ * @param settings The policies to follow. An event log at the given path is replaced.
+ */
+- (id)initWithProcessBackend:(id <SPSProcessBackend>)processBackend windowListSource:(id <SPSWindowListSource>)windowListSource scriptingEngine:(id <SPSScriptingEngine>)scriptingEngine settings:(SPSControllerSettings)settings;
+
+/**
+ * Queues a request to be dispatched with the next batch. Must be called on the main thread.
+ *
+ * A request for a URL that an earlier request is still opening does not open another tab. It is marked as a duplicate, and completes along with the earlier request, with its outcome.
+ *
+ * @param request A request that has not been dispatched yet, may not be nil.
+ */
+- (void)openRequest:(SPSURLRequest *)request;
+
+/**
+ * Calls a block on the main thread once the commands that have been queued so far have been sent, and what they led to on the main thread has been handled. Lets a harness tell when the controller has settled, without waiting for a fixed time.
+ *
+ * @param block A block, may not be nil.
+ */
+- (void)performAfterQueuedCommands:(void (^)(void))block;
+
 @end
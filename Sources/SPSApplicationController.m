@@ -20,43 +20,204 @@
 //
 
 #import "SPSApplicationController.h"
-#import "SPSSafari.h"
-#import "SPSSystemEvents.h"
+#import "SPSProcessRegistry.h"
+#import "SPSWorkspaceProcessBackend.h"
+#import "SPSProcessExitWatcher.h"
+#import "SPSSpaceWindowIndex.h"
+#import "SPSCoalescer.h"
+#import "SPSScriptingExecutor.h"
+#import "SPSSafariDriver.h"
+#import "SPSCircuitBreaker.h"
+#import "SPSScriptingBridgeEngine.h"
+#import "SPSAppleEventEngine.h"
+#import "SPSWindowPool.h"
+#import "SPSURLRequest.h"
+#import "SPSEventRecorder.h"
+#import "SPSMetricsServer.h"
+#import "SPSMetrics.h"
+#import "SPSTrace.h"
+#import <sys/sysctl.h>
+#import <sys/time.h>
 
 
-#define SAFARI_BUNDLE_IDENTIFIER @"com.apple.Safari"
-#define SYSTEM_EVENTS_BUNDLE_IDENTIFIER @"com.apple.systemevents"
+/**
+ * Keywords of the record that is sent back in reply to a GetURL event.
+ */
+#define SPSWindowIdentifierKeyword 'SPwi'
+#define SPSTabIndexKeyword 'SPti'
+
+
+/**
+ * Returns the time since this process was executed, in seconds, or 0 if it is not known.
+ */
+static NSTimeInterval SPSTimeSinceExec(void) {
+	int name[4] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()};
+	struct kinfo_proc process;
+	size_t size = sizeof(process);
+	
+	if (sysctl(name, 4, &process, &size, NULL, 0) != 0 || size == 0) {
+		return 0.0;
+	}
+	
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	
+	struct timeval startTime = process.kp_proc.p_starttime;
+	return (now.tv_sec - startTime.tv_sec) + (now.tv_usec - startTime.tv_usec) / 1000000.0;
+}
+
+
+SPSControllerSettings SPSDefaultControllerSettings(void) {
+	SPSControllerSettings settings;
+	settings.usesWindowPool = NO;
+	settings.eventLogPath = nil;
+	settings.usesAppleEventEngine = NO;
+	settings.circuitBreakerFailureThreshold = SPS_CIRCUIT_BREAKER_FAILURE_THRESHOLD;
+	settings.circuitBreakerCooldown = SPS_CIRCUIT_BREAKER_COOLDOWN;
+	return settings;
+}
+
+SPSControllerSettings SPSControllerSettingsFromUserDefaults(void) {
+	NSUserDefaults *userDefaults = [NSUserDefaults standardUserDefaults];
+	
+	SPSControllerSettings settings = SPSDefaultControllerSettings();
+	settings.usesWindowPool = [userDefaults boolForKey:SPS_WINDOW_POOL_DEFAULT];
+	settings.eventLogPath = [[userDefaults stringForKey:SPS_RECORD_EVENTS_DEFAULT] stringByExpandingTildeInPath];
+	settings.usesAppleEventEngine = [[userDefaults stringForKey:SPS_SCRIPTING_ENGINE_DEFAULT] isEqualToString:@"AppleEvents"];
+	return settings;
+}
 
 
 @interface SPSApplicationController ()
 
 /**
- * Activates a Safari window in the current space, creating a new one if necessary.
+ * Makes sure the application is started, hidden, when the user logs in.
  */
-- (void)activateWindowInCurrentSpace;
+- (void)addToLoginItems;
 
 /**
- * Opens the given URL using Safari.
- *
- * @param URL A URL, may not be nil.
+ * Launches Safari hidden and without activating it, if it is not running, so that the first link does not wait for Safari to start.
  */
-- (void)openURL:(NSURL *)URL;
+- (void)warmUpSafari;
 
 /**
- * Returns the current Safari process, or nil if Safari is not running.
+ * Returns the identifier of the running Safari process, or 0 if Safari is not running, and makes sure its exit will be noticed.
  */
-- (SPSSystemEventsProcess *)safariProcess;
+- (pid_t)safariProcessIdentifier;
 
 /**
- * Returns the current Safari application, starting Safari if necessary.
+ * Drops everything that is known about the given Safari process, which has exited, so that the next URL goes straight to launching Safari.
+ */
+- (void)safariDidExitWithProcessIdentifier:(pid_t)processIdentifier;
+
+/**
+ * Returns the Safari window in the current space that URLs should go to.
+ *
+ * @param processIdentifier The identifier of the running Safari process, or 0 if Safari is not running.
+ * @return A window identifier, SPS_NO_WINDOW if there is no Safari window in the current space, or SPS_UNKNOWN_WINDOW if Safari is not running.
+ */
+- (NSInteger)targetWindowIdentifierWithProcessIdentifier:(pid_t)processIdentifier;
+
+/**
+ * Replies to the suspended Apple Event of the given request with its outcome and resumes it.
+ *
+ * @param request A dispatched request, may not be nil.
  */
-- (SPSSafariApplication *)safariApplication;
+- (void)replyToRequest:(SPSURLRequest *)request;
 
 @end
 
 
 @implementation SPSApplicationController
 
+- (id)init {
+	return [self initWithSettings:SPSControllerSettingsFromUserDefaults()];
+}
+
+- (id)initWithSettings:(SPSControllerSettings)settings {
+	SPSWorkspaceProcessBackend *processBackend = [[SPSWorkspaceProcessBackend alloc] init];
+	SPSWindowServerWindowListSource *windowServerSource = [[SPSWindowServerWindowListSource alloc] init];
+	
+	// Raw Apple Events can be chosen over ScriptingBridge, to compare the two
+	id <SPSScriptingEngine> scriptingEngine;
+	if (settings.usesAppleEventEngine) {
+		scriptingEngine = [[SPSAppleEventEngine alloc] init];
+	}
+	else {
+		scriptingEngine = [[SPSScriptingBridgeEngine alloc] init];
+	}
+	
+	self = [self initWithProcessBackend:processBackend windowListSource:windowServerSource scriptingEngine:scriptingEngine settings:settings];
+	
+	[processBackend release];
+	[windowServerSource release];
+	[scriptingEngine release];
+	return self;
+}
+
+- (id)initWithProcessBackend:(id <SPSProcessBackend>)processBackend windowListSource:(id <SPSWindowListSource>)aWindowListSource scriptingEngine:(id <SPSScriptingEngine>)scriptingEngine settings:(SPSControllerSettings)settings {
+	if ((self = [super init])) {
+		processRegistry = [[SPSProcessRegistry alloc] initWithBackend:processBackend];
+		windowListSource = [aWindowListSource retain];
+		spaceWindowIndex = [[SPSSpaceWindowIndex alloc] initWithSource:windowListSource];
+		
+		[[[NSWorkspace sharedWorkspace] notificationCenter] addObserver:self selector:@selector(activeSpaceDidChange:) name:NSWorkspaceActiveSpaceDidChangeNotification object:nil];
+		
+		outstandingRequests = [[NSMutableDictionary alloc] init];
+		duplicateRequests = [[NSMutableDictionary alloc] init];
+		
+		// All Apple Events are sent from the executor thread, which also owns the driver
+		scriptingExecutor = [[SPSScriptingExecutor alloc] init];
+		SPSCircuitBreaker *circuitBreaker = [[SPSCircuitBreaker alloc] initWithFailureThreshold:settings.circuitBreakerFailureThreshold cooldown:settings.circuitBreakerCooldown];
+		SPSSafariDriver *safariDriver = [[SPSSafariDriver alloc] initWithEngine:scriptingEngine circuitBreaker:circuitBreaker];
+		[circuitBreaker release];
+		
+		SPSCoalescer *coalescer = [[SPSCoalescer alloc] init];
+		SPSWindowPool *windowPool = settings.usesWindowPool ? [[SPSWindowPool alloc] init] : nil;
+		dispatcher = [[SPSDispatcher alloc] initWithSafariDriver:safariDriver spaceWindowIndex:spaceWindowIndex coalescer:coalescer windowPool:windowPool delegate:self];
+		[safariDriver release];
+		[coalescer release];
+		[windowPool release];
+		
+		// The dispatcher keeps real time, and calls us back on the main queue
+		SPSScriptingExecutor *executor = scriptingExecutor;
+		[dispatcher setExecutor:^BOOL(void (^job)(void)) {
+			return [executor enqueueBlock:job];
+		}];
+		
+		// Recording keeps the active space at hand, so that events do not have to ask the window server for it
+		if (settings.eventLogPath != nil) {
+			eventRecorder = [[SPSEventRecorder alloc] initWithPath:settings.eventLogPath startTime:[NSDate timeIntervalSinceReferenceDate]];
+			recordedSpaceIdentifier = [windowListSource activeSpaceIdentifier];
+		}
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[[[NSWorkspace sharedWorkspace] notificationCenter] removeObserver:self];
+	[dispatcher invalidate];
+	[dispatcher release];
+	[processRegistry release];
+	[safariExitWatcher cancel];
+	[safariExitWatcher release];
+	[spaceWindowIndex release];
+	[windowObserver invalidate];
+	[windowObserver release];
+	[outstandingRequests release];
+	[duplicateRequests release];
+	[firstRequest release];
+	[scriptingExecutor invalidate];
+	[scriptingExecutor release];
+	[windowListSource release];
+	[eventRecorder release];
+	[metricsServer invalidate];
+	[metricsServer release];
+	[openServer invalidate];
+	[openServer release];
+	[super dealloc];
+}
+
 #pragma mark NSApplicationDelegate
 
 - (void)applicationWillFinishLaunching:(NSNotification *)aNotification {
@@ -64,60 +225,328 @@
 	[[NSAppleEventManager sharedAppleEventManager] setEventHandler:self andSelector:@selector(handleGetURLEvent:withReplyEvent:) forEventClass:kInternetEventClass andEventID:kAEGetURL];
 }
 
+- (void)applicationDidFinishLaunching:(NSNotification *)aNotification {
+	// From here on, URL events are handled as they come in
+	NSTimeInterval startupTime = SPSTimeSinceExec();
+	SPSCounterAdd(SPSCounterStartupMicroseconds, (int64_t)(startupTime * 1000000.0));
+	if (startupTime > SPS_STARTUP_BUDGET) {
+		SPSCounterAdd(SPSCounterStartupBudgetMisses, 1);
+	}
+	
+	// An agent stays around with its caches warm, so it should also be there before the first link after login
+	if ([[NSUserDefaults standardUserDefaults] boolForKey:SPS_AGENT_MODE_DEFAULT]) {
+		[self addToLoginItems];
+	}
+	
+	if ([[NSUserDefaults standardUserDefaults] boolForKey:SPS_WARM_UP_DEFAULT]) {
+		[self warmUpSafari];
+	}
+	
+	// The socket is only set up once launched, so that it does not count against the startup budget
+	NSString *metricsPath = [[NSUserDefaults standardUserDefaults] stringForKey:SPS_METRICS_SOCKET_DEFAULT];
+	if (metricsPath == nil) {
+		metricsPath = [SPSMetricsServer defaultPath];
+	}
+	if ([metricsPath length] > 0) {
+		metricsServer = [[SPSMetricsServer alloc] initWithPath:[metricsPath stringByExpandingTildeInPath]];
+	}
+	
+	// Scripts can stream URLs to us directly, rather than through Launch Services and a GetURL event each
+	NSString *openPath = [[NSUserDefaults standardUserDefaults] stringForKey:SPS_OPEN_SOCKET_DEFAULT];
+	if (openPath == nil) {
+		openPath = [SPSOpenServer defaultPath];
+	}
+	if ([openPath length] > 0) {
+		openServer = [[SPSOpenServer alloc] initWithPath:[openPath stringByExpandingTildeInPath] delegate:self];
+	}
+}
+
+- (void)applicationWillTerminate:(NSNotification *)aNotification {
+	[eventRecorder close];
+	[metricsServer invalidate];
+	[openServer invalidate];
+}
+
 - (void)applicationWillBecomeActive:(NSNotification *)aNotification {
-	[self activateWindowInCurrentSpace];
+	[eventRecorder recordEventOfType:SPSEventTypeActivation URLString:nil spaceIdentifier:recordedSpaceIdentifier atTime:[NSDate timeIntervalSinceReferenceDate]];
+	
+	[dispatcher activateWindowInCurrentSpace];
+}
+
+#pragma mark NSWorkspace notifications
+
+- (void)activeSpaceDidChange:(NSNotification *)notification {
+	[dispatcher activeSpaceDidChange];
+	
+	if (eventRecorder != nil) {
+		recordedSpaceIdentifier = [windowListSource activeSpaceIdentifier];
+	}
+}
+
+#pragma mark SPSWindowObserverDelegate
+
+- (void)windowObserver:(SPSWindowObserver *)observer didObserveCreationOfWindow:(NSInteger)windowIdentifier {
+	[dispatcher windowWasCreated:windowIdentifier];
+}
+
+- (void)windowObserver:(SPSWindowObserver *)observer didObserveDestructionOfWindow:(NSInteger)windowIdentifier {
+	[dispatcher windowWasDestroyed:windowIdentifier];
+}
+
+- (void)windowObserver:(SPSWindowObserver *)observer didObserveFrontWindow:(NSInteger)windowIdentifier {
+	[dispatcher windowDidComeToFront:windowIdentifier];
+}
+
+- (void)windowObserverDidLoseTrack:(SPSWindowObserver *)observer {
+	[dispatcher windowsDidGoUnobserved];
+}
+
+- (void)windowObserverDidStartObserving:(SPSWindowObserver *)observer {
+	// Windows made before the observer was ready were only seen by refreshing, so the index cannot be trusted to be current until it is refreshed once more
+	[spaceWindowIndex invalidate];
 }
 
 #pragma mark NSAppleEventManager handlers
 
 - (void)handleGetURLEvent:(NSAppleEventDescriptor *)event withReplyEvent:(NSAppleEventDescriptor *)replyEvent {
 	// Get the URL from the event descriptor
+	uint64_t traceBeginTime = SPSTraceBegin();
 	NSString *URLString = [[event paramDescriptorForKeyword:keyDirectObject] stringValue];
 	NSURL *URL = [NSURL URLWithString:URLString];
+	SPSTraceEnd(SPSTracePhaseParseURL, traceBeginTime);
 
 	if (URL != nil) {
-		[self activateWindowInCurrentSpace];
-		[self openURL:URL];
+		[eventRecorder recordEventOfType:SPSEventTypeURL URLString:URLString spaceIdentifier:recordedSpaceIdentifier atTime:[NSDate timeIntervalSinceReferenceDate]];
+		
+		// Return to the sender right away, and reply once the URL has actually been dispatched
+		NSAppleEventManagerSuspensionID suspensionID = [[NSAppleEventManager sharedAppleEventManager] suspendCurrentAppleEvent];
+		SPSURLRequest *request = [[SPSURLRequest alloc] initWithURL:URL suspensionID:suspensionID deadline:[NSDate timeIntervalSinceReferenceDate] + SPS_URL_REQUEST_BUDGET];
+		[self openRequest:request];
+		[request release];
+	}
+}
+
+#pragma mark SPSOpenServerDelegate
+
+- (void)openServer:(SPSOpenServer *)server didReceiveRequest:(SPSURLRequest *)request {
+	[eventRecorder recordEventOfType:SPSEventTypeURL URLString:[[request URL] absoluteString] spaceIdentifier:recordedSpaceIdentifier atTime:[NSDate timeIntervalSinceReferenceDate]];
+	
+	[self openRequest:request];
+}
+
+#pragma mark SPSDispatcherDelegate
+
+- (pid_t)safariProcessIdentifierForDispatcher:(SPSDispatcher *)aDispatcher {
+	return [self safariProcessIdentifier];
+}
+
+- (NSInteger)dispatcher:(SPSDispatcher *)aDispatcher targetWindowIdentifierWithProcessIdentifier:(pid_t)processIdentifier {
+	return [self targetWindowIdentifierWithProcessIdentifier:processIdentifier];
+}
+
+- (void)dispatcher:(SPSDispatcher *)aDispatcher didDispatchRequests:(NSArray *)requests {
+	for (SPSURLRequest *request in requests) {
+		[self replyToRequest:request];
 	}
 }
 
 #pragma mark SPSApplicationController
 
-- (void)activateWindowInCurrentSpace {
-	SPSSafariApplication *safariApplication = [self safariApplication];
+- (void)openRequest:(SPSURLRequest *)request {
+	NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+	NSURL *URL = [request URL];
 	
-	// In any case, activate Safari
-	[safariApplication activate];
+	// Every sender of a URL that is already on its way gets the tab it opens, rather than one of them getting a tab of its own
+	SPSURLRequest *outstandingRequest = [outstandingRequests objectForKey:URL];
+	if (outstandingRequest != nil && ![outstandingRequest isCancelled]) {
+		SPSCounterAdd(SPSCounterMergedRequests, 1);
+		[request setDuplicate:YES];
+		
+		NSMutableArray *duplicates = [duplicateRequests objectForKey:URL];
+		if (duplicates == nil) {
+			duplicates = [NSMutableArray array];
+			[duplicateRequests setObject:duplicates forKey:URL];
+		}
+		[duplicates addObject:request];
+		return;
+	}
+	[outstandingRequests setObject:request forKey:URL];
 	
-	// Make a window in the current space, if necessary
-	if ([[[self safariProcess] windows] count] == 0) {
-		SPSSafariDocument *document = [[[safariApplication classForScriptingClass:@"document"] alloc] init];
-		[[safariApplication documents] addObject:document];
-		[document release];
+	// Follow the first link to see what a cold or warm Safari costs
+	if (firstRequest == nil && !measuredFirstRequest) {
+		firstRequest = [request retain];
+		firstRequestTime = now;
+		firstRequestFoundSafariRunning = ([processRegistry processIdentifierForBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER] != 0);
 	}
+	
+	[dispatcher openRequest:request];
 }
 
-- (void)openURL:(NSURL *)URL {
-	[[NSWorkspace sharedWorkspace] openURLs:[NSArray arrayWithObject:URL] withAppBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER options:NSWorkspaceLaunchDefault additionalEventParamDescriptor:nil launchIdentifiers:NULL];
+- (void)performAfterQueuedCommands:(void (^)(void))block {
+	void (^mainBlock)(void) = [[block copy] autorelease];
+	
+	// The executor runs blocks in order, and what they hand to the main queue is queued before this
+	BOOL queued = [scriptingExecutor enqueueBlock:^{
+		dispatch_async(dispatch_get_main_queue(), mainBlock);
+	}];
+	
+	if (!queued) {
+		dispatch_async(dispatch_get_main_queue(), mainBlock);
+	}
 }
 
-- (SPSSystemEventsProcess *)safariProcess {
-	SPSSystemEventsProcess *process = nil;
+- (void)warmUpSafari {
+	if ([processRegistry processIdentifierForBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER] != 0) {
+		return;
+	}
 	
-	// Walk the system processes to find the Safari process, if it exists
-	SPSSystemEventsApplication *systemEventsApplication = [SBApplication applicationWithBundleIdentifier:SYSTEM_EVENTS_BUNDLE_IDENTIFIER];
-	for (SPSSystemEventsProcess *candidateProcess in [systemEventsApplication processes]) {
-		if ([[candidateProcess bundleIdentifier] isEqualToString:SAFARI_BUNDLE_IDENTIFIER]) {
-			process = candidateProcess;
-			break;
-		}
+	// Safari's windows stay hidden, so the index finds none in the current space and the first link still gets a window here
+	SPSCounterAdd(SPSCounterSafariWarmUps, 1);
+	[[NSWorkspace sharedWorkspace] launchAppWithBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER options:(NSWorkspaceLaunchWithoutActivation | NSWorkspaceLaunchAndHide) additionalEventParamDescriptor:nil launchIdentifier:NULL];
+}
+
+- (void)addToLoginItems {
+	LSSharedFileListRef loginItems = LSSharedFileListCreate(NULL, kLSSharedFileListSessionLoginItems, NULL);
+	if (loginItems == NULL) {
+		return;
+	}
+	
+	// Inserting an item that is already in the list only moves it
+	NSDictionary *properties = [NSDictionary dictionaryWithObject:[NSNumber numberWithBool:YES] forKey:(id)kLSSharedFileListLoginItemHidden];
+	LSSharedFileListItemRef item = LSSharedFileListInsertItemURL(loginItems, kLSSharedFileListItemLast, NULL, NULL, (CFURLRef)[[NSBundle mainBundle] bundleURL], (CFDictionaryRef)properties, NULL);
+	if (item != NULL) {
+		CFRelease(item);
+	}
+	
+	CFRelease(loginItems);
+}
+
+- (pid_t)safariProcessIdentifier {
+	pid_t processIdentifier = [processRegistry processIdentifierForBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER];
+	
+	if (processIdentifier != 0 && [safariExitWatcher processIdentifier] != processIdentifier) {
+		[safariExitWatcher cancel];
+		[safariExitWatcher release];
+		
+		// The watcher is owned by us, so its handler should not retain us
+		__block SPSApplicationController *controller = self;
+		safariExitWatcher = [[SPSProcessExitWatcher alloc] initWithProcessIdentifier:processIdentifier handler:^(pid_t exitedProcessIdentifier) {
+			[controller safariDidExitWithProcessIdentifier:exitedProcessIdentifier];
+		}];
 	}
 	
-	return process;
+	return processIdentifier;
 }
 
-- (SPSSafariApplication *)safariApplication {
-	return [SBApplication applicationWithBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER];
+- (void)safariDidExitWithProcessIdentifier:(pid_t)processIdentifier {
+	SPSCounterAdd(SPSCounterSafariExits, 1);
+	
+	// Do not wait for the workspace to tell us, which can take a while
+	[processRegistry removeProcessWithIdentifier:processIdentifier];
+	
+	[safariExitWatcher release];
+	safariExitWatcher = nil;
+	
+	[windowObserver invalidate];
+	[windowObserver release];
+	windowObserver = nil;
+	
+	[dispatcher safariDidExit];
+}
+
+- (NSInteger)targetWindowIdentifierWithProcessIdentifier:(pid_t)processIdentifier {
+	if (processIdentifier == 0) {
+		return SPS_UNKNOWN_WINDOW;
+	}
+	
+	uint64_t traceBeginTime = SPSTraceBegin();
+	
+	// Follow window changes of a new Safari process as they happen. The observer is set up in the background, and the index is refreshed every time until it is ready
+	if ([windowObserver processIdentifier] != processIdentifier) {
+		[windowObserver invalidate];
+		[windowObserver release];
+		windowObserver = [[SPSWindowObserver alloc] initWithProcessIdentifier:processIdentifier delegate:self];
+		[spaceWindowIndex invalidate];
+	}
+	
+	// Without observed window changes, the index has to be refreshed every time
+	NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+	if (![windowObserver isObserving] || [spaceWindowIndex needsRefreshWithProcessIdentifier:processIdentifier atTime:now]) {
+		SPSCounterAdd(SPSCounterWindowIndexResyncs, 1);
+		[spaceWindowIndex refreshWithProcessIdentifier:processIdentifier atTime:now];
+	}
+	else {
+		SPSCounterAdd(SPSCounterWindowIndexHits, 1);
+	}
+	
+	NSInteger windowIdentifier = [spaceWindowIndex targetWindowIdentifier];
+	SPSTraceEnd(SPSTracePhaseTargetWindow, traceBeginTime);
+	return windowIdentifier;
+}
+
+- (void)replyToRequest:(SPSURLRequest *)request {
+	NSAppleEventManager *appleEventManager = [NSAppleEventManager sharedAppleEventManager];
+	NSAppleEventManagerSuspensionID suspensionID = [request suspensionID];
+	
+	if (request == firstRequest) {
+		// Safari has painted nothing before it has been handed the URL, so this is as close to the first paint as we can see
+		NSTimeInterval latency = [NSDate timeIntervalSinceReferenceDate] - firstRequestTime;
+		SPSCounterAdd(firstRequestFoundSafariRunning ? SPSCounterWarmFirstLinkMicroseconds : SPSCounterColdFirstLinkMicroseconds, (int64_t)(latency * 1000000.0));
+		
+		[firstRequest release];
+		firstRequest = nil;
+		measuredFirstRequest = YES;
+	}
+	
+	SPSHistogramRecord(SPSHistogramLinkMicroseconds, (int64_t)(([NSDate timeIntervalSinceReferenceDate] - [request creationTime]) * 1000000.0));
+	
+	// Duplicates complete along with the request they were merged into, unless it was cancelled, in which case they still have to be opened
+	NSArray *duplicates = nil;
+	if ([outstandingRequests objectForKey:[request URL]] == request) {
+		duplicates = [[[duplicateRequests objectForKey:[request URL]] retain] autorelease];
+		[duplicateRequests removeObjectForKey:[request URL]];
+		[outstandingRequests removeObjectForKey:[request URL]];
+	}
+	
+	if ([request completionHandler] != nil) {
+		[request completionHandler](request);
+	}
+	
+	for (SPSURLRequest *duplicate in duplicates) {
+		if ([request isCancelled] && [request error] != nil) {
+			[duplicate setDuplicate:NO];
+			[self openRequest:duplicate];
+		}
+		else {
+			[duplicate setWindowIdentifier:[request windowIdentifier]];
+			[duplicate setTabIndex:[request tabIndex]];
+			[duplicate setError:[request error]];
+			[self replyToRequest:duplicate];
+		}
+	}
+	
+	if (suspensionID == NULL) {
+		return;
+	}
+	
+	// Only fill in the reply if the sender asked for one
+	NSAppleEventDescriptor *replyEvent = [appleEventManager replyAppleEventForSuspensionID:suspensionID];
+	if ([replyEvent descriptorType] != typeNull) {
+		NSError *error = [request error];
+		
+		if (error != nil) {
+			[replyEvent setParamDescriptor:[NSAppleEventDescriptor descriptorWithInt32:(SInt32)[error code]] forKeyword:keyErrorNumber];
+			[replyEvent setParamDescriptor:[NSAppleEventDescriptor descriptorWithString:[error localizedDescription]] forKeyword:keyErrorString];
+		}
+		else {
+			NSAppleEventDescriptor *outcome = [NSAppleEventDescriptor recordDescriptor];
+			[outcome setDescriptor:[NSAppleEventDescriptor descriptorWithInt32:(SInt32)[request windowIdentifier]] forKeyword:SPSWindowIdentifierKeyword];
+			[outcome setDescriptor:[NSAppleEventDescriptor descriptorWithInt32:(SInt32)[request tabIndex]] forKeyword:SPSTabIndexKeyword];
+			[replyEvent setParamDescriptor:outcome forKeyword:keyDirectObject];
+		}
+	}
+	
+	[appleEventManager resumeWithSuspensionID:suspensionID];
 }
 
 @end
@@ -0,0 +1,91 @@
+//
+//  SPSBulkImporter.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Cocoa/Cocoa.h>
+
+
+@class SPSURLFileReader, SPSApplicationController;
+
+
+/**
+ * The user defaults key of the number of tabs that may be loading at once during a bulk import. Defaults to SPS_BULK_IMPORT_LOADING_TABS.
+ */
+#define SPS_BULK_IMPORT_LOADING_TABS_DEFAULT @"BulkImportLoadingTabs"
+#define SPS_BULK_IMPORT_LOADING_TABS 8
+
+/**
+ * The user defaults key of the number of tabs a bulk import puts in a window before it starts another one. Defaults to SPS_BULK_IMPORT_TABS_PER_WINDOW.
+ */
+#define SPS_BULK_IMPORT_TABS_PER_WINDOW_DEFAULT @"BulkImportTabsPerWindow"
+#define SPS_BULK_IMPORT_TABS_PER_WINDOW 20
+
+/**
+ * The time a tab is taken to be loading after its URL has been handed to Safari, in seconds. Safari does not tell when a page is done without asking it for every tab, so this stands in for that.
+ */
+#define SPS_BULK_IMPORT_LOAD_TIME 3.0
+
+/**
+ * The time between progress reports, in seconds.
+ */
+#define SPS_BULK_IMPORT_PROGRESS_INTERVAL 1.0
+
+
+/**
+ * Opens a file of URLs, however large, without overwhelming Safari.
+ *
+ * The URLs are read as they are needed and handed to the controller in small batches. A batch is only sent once the one before it has been dispatched and there is room among the tabs that are still loading. Every batch goes to the window the import is filling, and a new window is started in the current space once that one has its share of tabs.
+ *
+ * Lines of the file that are not URLs are counted as failed URLs. Progress is written to standard error every second, and the totals and throughput to standard output at the end, after which the tool is terminated. Only a handful of URLs are held at any time, so memory use does not grow with the size of the file.
+ */
+@interface SPSBulkImporter : NSObject {
+	SPSURLFileReader *reader;
+	SPSApplicationController *controller;
+	NSUInteger maximumLoadingTabCount;
+	NSUInteger tabsPerWindow;
+	NSMutableArray *loadStartTimes;
+	NSUInteger pendingRequestCount;
+	NSUInteger openedCount;
+	NSUInteger failedCount;
+	NSUInteger duplicateCount;
+	NSUInteger windowCount;
+	NSInteger currentWindowIdentifier;
+	NSInteger currentWindowTabCount;
+	BOOL needsNewWindow;
+	BOOL readAllURLs;
+	NSTimeInterval startTime;
+}
+
+/**
+ * Initializes the importer.
+ *
+ * @param aReader The reader to take URLs from, may not be nil.
+ * @param aController The controller to open the URLs with, may not be nil.
+ * @param aMaximumLoadingTabCount The number of tabs that may be loading at once, at least 1.
+ * @param aTabsPerWindow The number of tabs to put in a window, at least 1.
+ */
+- (id)initWithReader:(SPSURLFileReader *)aReader controller:(SPSApplicationController *)aController maximumLoadingTabCount:(NSUInteger)aMaximumLoadingTabCount tabsPerWindow:(NSUInteger)aTabsPerWindow;
+
+/**
+ * Starts opening URLs on the main run loop, in a new window.
+ */
+- (void)start;
+
+@end
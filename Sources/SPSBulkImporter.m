@@ -0,0 +1,211 @@
+//
+//  SPSBulkImporter.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSBulkImporter.h"
+#import "SPSURLFileReader.h"
+#import "SPSApplicationController.h"
+#import "SPSURLRequest.h"
+
+
+@interface SPSBulkImporter ()
+
+/**
+ * Sends the next batch of URLs if there is room for it, or tries again once there is.
+ */
+- (void)openNextURLs;
+
+/**
+ * Accounts for a URL that has been dispatched, and moves on once its batch is done.
+ */
+- (void)requestDidComplete:(SPSURLRequest *)request;
+
+/**
+ * Writes the progress so far to standard error, and again every SPS_BULK_IMPORT_PROGRESS_INTERVAL seconds until the import is done.
+ */
+- (void)reportProgress;
+
+/**
+ * Returns the number of URLs that could not be opened so far, including lines of the file that are not URLs.
+ */
+- (NSUInteger)failedURLCount;
+
+/**
+ * Writes the totals to standard output and terminates.
+ */
+- (void)finish;
+
+@end
+
+
+@implementation SPSBulkImporter
+
+- (id)initWithReader:(SPSURLFileReader *)aReader controller:(SPSApplicationController *)aController maximumLoadingTabCount:(NSUInteger)aMaximumLoadingTabCount tabsPerWindow:(NSUInteger)aTabsPerWindow {
+	if ((self = [super init])) {
+		reader = [aReader retain];
+		controller = [aController retain];
+		maximumLoadingTabCount = MAX(aMaximumLoadingTabCount, 1);
+		tabsPerWindow = MAX(aTabsPerWindow, 1);
+		loadStartTimes = [[NSMutableArray alloc] initWithCapacity:maximumLoadingTabCount];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[NSObject cancelPreviousPerformRequestsWithTarget:self];
+	[reader release];
+	[controller release];
+	[loadStartTimes release];
+	[super dealloc];
+}
+
+- (void)start {
+	startTime = [NSDate timeIntervalSinceReferenceDate];
+	
+	// Progress is reported on a clock of its own, so that it keeps coming while batches are held back or Safari is slow
+	[self performSelector:@selector(reportProgress) withObject:nil afterDelay:SPS_BULK_IMPORT_PROGRESS_INTERVAL];
+	
+	// The imported tabs are kept together, apart from what was already open
+	needsNewWindow = YES;
+	
+	[self openNextURLs];
+}
+
+#pragma mark SPSBulkImporter
+
+- (void)openNextURLs {
+	if (pendingRequestCount > 0) {
+		return;
+	}
+	
+	NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+	
+	// Tabs that have had their time to load no longer count against the limit
+	while ([loadStartTimes count] > 0 && [[loadStartTimes objectAtIndex:0] doubleValue] + SPS_BULK_IMPORT_LOAD_TIME <= now) {
+		[loadStartTimes removeObjectAtIndex:0];
+	}
+	
+	NSUInteger freeTabCount = maximumLoadingTabCount - [loadStartTimes count];
+	if (freeTabCount == 0) {
+		NSTimeInterval delay = [[loadStartTimes objectAtIndex:0] doubleValue] + SPS_BULK_IMPORT_LOAD_TIME - now;
+		[self performSelector:@selector(openNextURLs) withObject:nil afterDelay:delay];
+		return;
+	}
+	
+	if (currentWindowTabCount >= (NSInteger)tabsPerWindow) {
+		needsNewWindow = YES;
+	}
+	NSUInteger windowTabCount = needsNewWindow ? 0 : (NSUInteger)currentWindowTabCount;
+	NSUInteger batchSize = MIN(freeTabCount, tabsPerWindow - windowTabCount);
+	
+	// All requests of the batch are added at once, so that they are dispatched as a single batch
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+	for (NSUInteger index = 0; index < batchSize; index++) {
+		NSURL *URL = [reader nextURL];
+		if (URL == nil) {
+			readAllURLs = YES;
+			break;
+		}
+		
+		SPSURLRequest *request = [[SPSURLRequest alloc] initWithURL:URL suspensionID:NULL deadline:now + SPS_URL_REQUEST_BUDGET];
+		[request setOpensInNewWindow:(index == 0 && needsNewWindow)];
+		[request setCompletionHandler:^(SPSURLRequest *completedRequest) {
+			[self requestDidComplete:completedRequest];
+		}];
+		
+		pendingRequestCount++;
+		[loadStartTimes addObject:[NSNumber numberWithDouble:now]];
+		[controller openRequest:request];
+		[request release];
+	}
+	[pool release];
+	
+	if (pendingRequestCount > 0) {
+		needsNewWindow = NO;
+	}
+	else if (readAllURLs) {
+		[self finish];
+	}
+}
+
+- (void)requestDidComplete:(SPSURLRequest *)request {
+	pendingRequestCount--;
+	
+	// A URL that is in the file twice while the first is still being opened only gets one tab
+	if ([request error] != nil) {
+		failedCount++;
+	}
+	else if ([request isDuplicate]) {
+		duplicateCount++;
+	}
+	else {
+		openedCount++;
+	}
+	
+	// Follow the window the tabs went to, which is a new one whenever one was asked for
+	NSInteger windowIdentifier = [request windowIdentifier];
+	if (windowIdentifier > 0) {
+		if (windowIdentifier != currentWindowIdentifier) {
+			currentWindowIdentifier = windowIdentifier;
+			currentWindowTabCount = 0;
+			windowCount++;
+		}
+		currentWindowTabCount = MAX(currentWindowTabCount, [request tabIndex]);
+	}
+	
+	if (pendingRequestCount == 0) {
+		if (readAllURLs) {
+			[self finish];
+		}
+		else {
+			[self openNextURLs];
+		}
+	}
+}
+
+- (void)reportProgress {
+	NSTimeInterval elapsedTime = [NSDate timeIntervalSinceReferenceDate] - startTime;
+	double fraction = ([reader length] > 0) ? (double)[reader position] / [reader length] : 1.0;
+	
+	fprintf(stderr, "%lu opened, %lu failed, %lu duplicates, %.0f%% read, %.1f urls/s, %lu windows\n", (unsigned long)openedCount, (unsigned long)[self failedURLCount], (unsigned long)duplicateCount, fraction * 100.0, (elapsedTime > 0.0) ? openedCount / elapsedTime : 0.0, (unsigned long)windowCount);
+	
+	[self performSelector:@selector(reportProgress) withObject:nil afterDelay:SPS_BULK_IMPORT_PROGRESS_INTERVAL];
+}
+
+- (NSUInteger)failedURLCount {
+	return failedCount + [reader invalidLineCount];
+}
+
+- (void)finish {
+	NSTimeInterval elapsedTime = [NSDate timeIntervalSinceReferenceDate] - startTime;
+	[NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(reportProgress) object:nil];
+	
+	printf("urls %lu\n", (unsigned long)(openedCount + [self failedURLCount] + duplicateCount));
+	printf("failed_urls %lu\n", (unsigned long)[self failedURLCount]);
+	printf("duplicate_urls %lu\n", (unsigned long)duplicateCount);
+	printf("windows %lu\n", (unsigned long)windowCount);
+	printf("seconds %.1f\n", elapsedTime);
+	printf("urls_per_second %.1f\n", (elapsedTime > 0.0) ? openedCount / elapsedTime : 0.0);
+	fflush(stdout);
+	
+	[NSApp terminate:nil];
+}
+
+@end
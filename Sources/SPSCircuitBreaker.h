@@ -0,0 +1,95 @@
+//
+//  SPSCircuitBreaker.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#import <Foundation/Foundation.h>
+
+
+/**
+ * The number of timeouts in a row after which a breaker opens by default.
+ */
+#define SPS_CIRCUIT_BREAKER_FAILURE_THRESHOLD 3
+
+/**
+ * The time a breaker stays open by default before it lets a probe through, in seconds.
+ */
+#define SPS_CIRCUIT_BREAKER_COOLDOWN 10.0
+
+
+/**
+ * The states of a circuit breaker.
+ */
+typedef enum {
+	SPSCircuitBreakerStateClosed,
+	SPSCircuitBreakerStateOpen,
+	SPSCircuitBreakerStateHalfOpen
+} SPSCircuitBreakerState;
+
+
+/**
+ * Stops calls to a backend that keeps timing out, and lets a single probe through now and then to find out whether it has recovered.
+ *
+ * The breaker starts out closed, letting every call through. After a number of timeouts in a row it opens, and callers should take a degraded path instead. Once the cooldown has passed, the next call is let through as a probe while the breaker is half-open: if it succeeds the breaker closes, and if it times out the breaker opens again.
+ *
+ * The breaker does not keep time itself. All times are passed in by the caller, in seconds.
+ */
+@interface SPSCircuitBreaker : NSObject {
+	SPSCircuitBreakerState state;
+	NSUInteger consecutiveFailures;
+	NSUInteger failureThreshold;
+	NSTimeInterval cooldown;
+	NSTimeInterval openTime;
+}
+
+/**
+ * Initializes the breaker.
+ *
+ * @param aFailureThreshold The number of timeouts in a row after which the breaker opens.
+ * @param aCooldown The time the breaker stays open before it lets a probe through.
+ */
+- (id)initWithFailureThreshold:(NSUInteger)aFailureThreshold cooldown:(NSTimeInterval)aCooldown;
+
+/**
+ * Returns whether a call should go to the backend. If it does, its outcome must be recorded.
+ *
+ * @param time The time at which the call would be made.
+ */
+- (BOOL)allowsCallAtTime:(NSTimeInterval)time;
+
+/**
+ * Records that a call that was let through was answered.
+ */
+- (void)recordSuccessAtTime:(NSTimeInterval)time;
+
+/**
+ * Records that a call that was let through timed out.
+ */
+- (void)recordFailureAtTime:(NSTimeInterval)time;
+
+/**
+ * Records that a call that was let through never reached the backend, for example because its deadline had already passed, so that it says nothing about the backend. A probe that was skipped leaves the breaker open, and the next call is let through as a probe instead.
+ */
+- (void)recordSkippedCallAtTime:(NSTimeInterval)time;
+
+/**
+ * The current state.
+ */
+- (SPSCircuitBreakerState)state;
+
+@end
@@ -0,0 +1,92 @@
+//
+//  SPSCircuitBreaker.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#import "SPSCircuitBreaker.h"
+#import "SPSMetrics.h"
+
+
+@implementation SPSCircuitBreaker
+
+- (id)init {
+	return [self initWithFailureThreshold:SPS_CIRCUIT_BREAKER_FAILURE_THRESHOLD cooldown:SPS_CIRCUIT_BREAKER_COOLDOWN];
+}
+
+- (id)initWithFailureThreshold:(NSUInteger)aFailureThreshold cooldown:(NSTimeInterval)aCooldown {
+	if ((self = [super init])) {
+		state = SPSCircuitBreakerStateClosed;
+		failureThreshold = aFailureThreshold;
+		cooldown = aCooldown;
+	}
+	return self;
+}
+
+- (BOOL)allowsCallAtTime:(NSTimeInterval)time {
+	switch (state) {
+		case SPSCircuitBreakerStateClosed:
+			return YES;
+			
+		case SPSCircuitBreakerStateOpen:
+			// Let one probe through once the backend has had some rest
+			if (time - openTime >= cooldown) {
+				SPSCounterAdd(SPSCounterCircuitBreakerProbes, 1);
+				state = SPSCircuitBreakerStateHalfOpen;
+				return YES;
+			}
+			return NO;
+			
+		case SPSCircuitBreakerStateHalfOpen:
+			// The probe is still out
+			return NO;
+	}
+	
+	return YES;
+}
+
+- (void)recordSuccessAtTime:(NSTimeInterval)time {
+	if (state != SPSCircuitBreakerStateClosed) {
+		SPSCounterAdd(SPSCounterCircuitBreakerCloses, 1);
+		state = SPSCircuitBreakerStateClosed;
+	}
+	consecutiveFailures = 0;
+}
+
+- (void)recordFailureAtTime:(NSTimeInterval)time {
+	consecutiveFailures++;
+	
+	// A failed probe opens the breaker right away
+	if (state == SPSCircuitBreakerStateHalfOpen || (state == SPSCircuitBreakerStateClosed && consecutiveFailures >= failureThreshold)) {
+		SPSCounterAdd(SPSCounterCircuitBreakerOpens, 1);
+		state = SPSCircuitBreakerStateOpen;
+		openTime = time;
+	}
+}
+
+- (void)recordSkippedCallAtTime:(NSTimeInterval)time {
+	// The cooldown has already passed, so the time the breaker opened is kept
+	if (state == SPSCircuitBreakerStateHalfOpen) {
+		state = SPSCircuitBreakerStateOpen;
+	}
+}
+
+- (SPSCircuitBreakerState)state {
+	return state;
+}
+
+@end
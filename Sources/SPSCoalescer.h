@@ -0,0 +1,90 @@
+//
+//  SPSCoalescer.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ * The coalescing window bounds and maximum latency used by default, in seconds.
+ */
+#define SPS_COALESCING_MINIMUM_WINDOW 0.002
+#define SPS_COALESCING_MAXIMUM_WINDOW 0.025
+#define SPS_COALESCING_MAXIMUM_LATENCY 0.1
+
+
+/**
+ * Collects objects, such as URLs, that arrive in bursts so that they can be handled as one batch.
+ *
+ * A batch is due once no new object has arrived for the length of the coalescing window, or once its first object has waited for the maximum latency. The window adapts to the traffic: it widens while bursts keep arriving and narrows again when objects arrive one at a time, so that a single link is not held back for long.
+ *
+ * The coalescer does not keep time itself. All times are passed in by the caller, in seconds.
+ */
+@interface SPSCoalescer : NSObject {
+	NSMutableArray *pendingObjects;
+	NSTimeInterval firstArrivalTime;
+	NSTimeInterval lastArrivalTime;
+	NSTimeInterval window;
+	NSTimeInterval minimumWindow;
+	NSTimeInterval maximumWindow;
+	NSTimeInterval maximumLatency;
+}
+
+/**
+ * Initializes the coalescer with the given window bounds.
+ *
+ * @param aMinimumWindow The narrowest coalescing window.
+ * @param aMaximumWindow The widest coalescing window.
+ * @param aMaximumLatency The longest time the first object of a batch may wait.
+ */
+- (id)initWithMinimumWindow:(NSTimeInterval)aMinimumWindow maximumWindow:(NSTimeInterval)aMaximumWindow maximumLatency:(NSTimeInterval)aMaximumLatency;
+
+/**
+ * Adds an object to the pending batch.
+ *
+ * @param object An object, may not be nil.
+ * @param time The time at which the object arrived.
+ */
+- (void)addObject:(id)object atTime:(NSTimeInterval)time;
+
+/**
+ * Whether there are objects waiting to be flushed.
+ */
+- (BOOL)hasPendingObjects;
+
+/**
+ * Returns the time at which the pending batch is due, or 0 if there is no pending batch.
+ */
+- (NSTimeInterval)dueTime;
+
+/**
+ * Returns the pending batch and starts a new one, adapting the window to the size of the returned batch.
+ *
+ * @param time The time at which the batch is flushed.
+ * @return The objects in the order in which they were added, or an empty array.
+ */
+- (NSArray *)flushAtTime:(NSTimeInterval)time;
+
+/**
+ * The current coalescing window.
+ */
+- (NSTimeInterval)window;
+
+@end
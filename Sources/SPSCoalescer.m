@@ -0,0 +1,98 @@
+//
+//  SPSCoalescer.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSCoalescer.h"
+#import "SPSMetrics.h"
+
+
+@implementation SPSCoalescer
+
+- (id)init {
+	return [self initWithMinimumWindow:SPS_COALESCING_MINIMUM_WINDOW maximumWindow:SPS_COALESCING_MAXIMUM_WINDOW maximumLatency:SPS_COALESCING_MAXIMUM_LATENCY];
+}
+
+- (id)initWithMinimumWindow:(NSTimeInterval)aMinimumWindow maximumWindow:(NSTimeInterval)aMaximumWindow maximumLatency:(NSTimeInterval)aMaximumLatency {
+	if ((self = [super init])) {
+		pendingObjects = [[NSMutableArray alloc] init];
+		minimumWindow = aMinimumWindow;
+		maximumWindow = aMaximumWindow;
+		maximumLatency = aMaximumLatency;
+		window = minimumWindow;
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[pendingObjects release];
+	[super dealloc];
+}
+
+- (void)addObject:(id)object atTime:(NSTimeInterval)time {
+	if ([pendingObjects count] == 0) {
+		firstArrivalTime = time;
+	}
+	lastArrivalTime = time;
+	
+	[pendingObjects addObject:object];
+}
+
+- (BOOL)hasPendingObjects {
+	return [pendingObjects count] > 0;
+}
+
+- (NSTimeInterval)dueTime {
+	if ([pendingObjects count] == 0) {
+		return 0;
+	}
+	
+	return MIN(lastArrivalTime + window, firstArrivalTime + maximumLatency);
+}
+
+- (NSArray *)flushAtTime:(NSTimeInterval)time {
+	NSArray *batch = [[pendingObjects copy] autorelease];
+	NSUInteger batchSize = [batch count];
+	
+	if (batchSize > 0) {
+		SPSCounterAdd(SPSCounterURLBatches, 1);
+		SPSCounterAdd(SPSCounterBatchedURLs, batchSize);
+		SPSCounterRaise(SPSCounterLargestURLBatch, batchSize);
+		SPSCounterAdd(SPSCounterCoalescingMicroseconds, (int64_t)((time - firstArrivalTime) * 1000000.0));
+		SPSHistogramRecord(SPSHistogramCoalescingMicroseconds, (int64_t)((time - firstArrivalTime) * 1000000.0));
+		
+		// Widen the window while bursts keep arriving, and narrow it again for lone objects
+		if (batchSize > 1) {
+			window = MIN(window * 2.0, maximumWindow);
+		}
+		else {
+			window = MAX(window / 2.0, minimumWindow);
+		}
+		
+		[pendingObjects removeAllObjects];
+	}
+	
+	return batch;
+}
+
+- (NSTimeInterval)window {
+	return window;
+}
+
+@end
@@ -0,0 +1,57 @@
+//
+//  SPSConnectionCache.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import <ScriptingBridge/ScriptingBridge.h>
+
+
+/**
+ * Keeps one ScriptingBridge application object per bundle identifier, so that the LaunchServices lookup and scripting class setup behind each one is only paid once.
+ *
+ * Like the scripting engine that uses it, a cache may only be used from the executor thread.
+ */
+@interface SPSConnectionCache : NSObject {
+	id <SBApplicationDelegate> delegate;
+	NSMutableDictionary *applicationsByBundleIdentifier;
+}
+
+/**
+ * Initializes the cache.
+ *
+ * @param aDelegate The delegate to give every application object, or nil. Not retained.
+ */
+- (id)initWithDelegate:(id <SBApplicationDelegate>)aDelegate;
+
+/**
+ * Returns the application object for the given bundle identifier, creating it if there is none yet.
+ *
+ * @param bundleIdentifier A bundle identifier, may not be nil.
+ */
+- (id)applicationWithBundleIdentifier:(NSString *)bundleIdentifier;
+
+/**
+ * Forgets the application object for the given bundle identifier, for example because the application has exited or launched.
+ *
+ * @param bundleIdentifier A bundle identifier, may not be nil.
+ */
+- (void)removeApplicationWithBundleIdentifier:(NSString *)bundleIdentifier;
+
+@end
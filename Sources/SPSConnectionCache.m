@@ -0,0 +1,67 @@
+//
+//  SPSConnectionCache.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSConnectionCache.h"
+#import "SPSMetrics.h"
+
+
+@implementation SPSConnectionCache
+
+- (id)initWithDelegate:(id <SBApplicationDelegate>)aDelegate {
+	if ((self = [super init])) {
+		delegate = aDelegate;
+		applicationsByBundleIdentifier = [[NSMutableDictionary alloc] init];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[applicationsByBundleIdentifier release];
+	[super dealloc];
+}
+
+- (id)applicationWithBundleIdentifier:(NSString *)bundleIdentifier {
+	SBApplication *application = [applicationsByBundleIdentifier objectForKey:bundleIdentifier];
+	
+	if (application != nil) {
+		SPSCounterAdd(SPSCounterConnectionCacheHits, 1);
+		return application;
+	}
+	
+	// Measure what a connection costs, which is what the cache saves on every hit
+	NSTimeInterval startTime = [NSDate timeIntervalSinceReferenceDate];
+	application = [SBApplication applicationWithBundleIdentifier:bundleIdentifier];
+	[application setDelegate:delegate];
+	SPSCounterAdd(SPSCounterConnectionConstructions, 1);
+	SPSCounterAdd(SPSCounterConnectionConstructionMicroseconds, (int64_t)(([NSDate timeIntervalSinceReferenceDate] - startTime) * 1000000.0));
+	
+	if (application != nil) {
+		[applicationsByBundleIdentifier setObject:application forKey:bundleIdentifier];
+	}
+	
+	return application;
+}
+
+- (void)removeApplicationWithBundleIdentifier:(NSString *)bundleIdentifier {
+	[applicationsByBundleIdentifier removeObjectForKey:bundleIdentifier];
+}
+
+@end
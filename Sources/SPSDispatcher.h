@@ -0,0 +1,159 @@
+//
+//  SPSDispatcher.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+@class SPSDispatcher, SPSSafariDriver, SPSSpaceWindowIndex, SPSCoalescer, SPSWindowPool, SPSURLRequest;
+
+
+/**
+ * The time after switching to a space before a window is made for the pool, in seconds, so that passing through a space does not make one.
+ */
+#define SPS_WINDOW_POOL_DELAY 1.0
+
+
+/**
+ * Tells a dispatcher which Safari and which window it is dealing with, and hears back about the batches it dispatched. Called on the main thread.
+ */
+@protocol SPSDispatcherDelegate <NSObject>
+
+/**
+ * Returns the identifier of the running Safari process, or 0 if Safari is not running.
+ */
+- (pid_t)safariProcessIdentifierForDispatcher:(SPSDispatcher *)dispatcher;
+
+/**
+ * Returns the Safari window in the current space that URLs should go to.
+ *
+ * @param processIdentifier The identifier of the running Safari process, or 0 if Safari is not running.
+ * @return A window identifier, SPS_NO_WINDOW if there is no Safari window in the current space, or SPS_UNKNOWN_WINDOW if Safari is not running.
+ */
+- (NSInteger)dispatcher:(SPSDispatcher *)dispatcher targetWindowIdentifierWithProcessIdentifier:(pid_t)processIdentifier;
+
+/**
+ * Called once a batch has been handed to Safari, or has been given up on, with the outcome set on every request of it.
+ *
+ * @param requests The requests of the batch, in the order in which they were opened.
+ */
+- (void)dispatcher:(SPSDispatcher *)dispatcher didDispatchRequests:(NSArray *)requests;
+
+@end
+
+
+/**
+ * Decides what the Safari driver is asked to do, and when: URLs are coalesced into batches, a batch shares an activation that is already on its way, the window pool is kept filled, and the space window index and the driver hear about the windows that come and go.
+ *
+ * The dispatcher keeps no time and runs nothing by itself. It reads the time from its clock, hands jobs for the driver to its executor, and has its scheduler call it back on the main thread, either after a delay or once a job is done. The application controller runs it with the scripting executor in real time, and the simulator runs the very same policies in virtual time.
+ *
+ * A dispatcher may only be used from the main thread.
+ */
+@interface SPSDispatcher : NSObject {
+	id <SPSDispatcherDelegate> delegate;
+	SPSSafariDriver *safariDriver;
+	SPSSpaceWindowIndex *spaceWindowIndex;
+	SPSCoalescer *coalescer;
+	SPSWindowPool *windowPool;
+	NSMutableSet *windowsCreatedWhilePooling;
+	BOOL activationInFlight;
+	NSUInteger flushGeneration;
+	NSUInteger fillGeneration;
+	NSUInteger evictionGeneration;
+	BOOL invalidated;
+	NSTimeInterval (^clock)(void);
+	BOOL (^executor)(void (^job)(void));
+	void (^scheduler)(NSTimeInterval delay, void (^action)(void));
+}
+
+/**
+ * Initializes the dispatcher.
+ *
+ * @param aSafariDriver The driver that jobs are run against, may not be nil. It should only be used from the executor from now on.
+ * @param aSpaceWindowIndex The index of the windows in the current space, may not be nil. The delegate refreshes it when it looks up the target window.
+ * @param aCoalescer The coalescer that URLs are batched with, may not be nil.
+ * @param aWindowPool The window pool to keep filled, or nil to pool no windows.
+ * @param aDelegate The delegate, which is not retained.
+ */
+- (id)initWithSafariDriver:(SPSSafariDriver *)aSafariDriver spaceWindowIndex:(SPSSpaceWindowIndex *)aSpaceWindowIndex coalescer:(SPSCoalescer *)aCoalescer windowPool:(SPSWindowPool *)aWindowPool delegate:(id <SPSDispatcherDelegate>)aDelegate;
+
+/**
+ * A block that returns the current time, or nil to use +[NSDate timeIntervalSinceReferenceDate].
+ */
+@property (copy) NSTimeInterval (^clock)(void);
+
+/**
+ * A block that queues a job to be run after the ones queued before it, and returns whether it was queued. A job is not queued while this is nil.
+ */
+@property (copy) BOOL (^executor)(void (^job)(void));
+
+/**
+ * A block that calls an action on the main thread after the given delay in seconds, or nil to use the main dispatch queue. It is also called from jobs, with no delay, to hand back what they did.
+ */
+@property (copy) void (^scheduler)(NSTimeInterval delay, void (^action)(void));
+
+/**
+ * Queues a request to be dispatched with the next batch.
+ *
+ * @param request A request that has not been dispatched yet, may not be nil.
+ */
+- (void)openRequest:(SPSURLRequest *)request;
+
+/**
+ * Activates a Safari window in the current space, creating a new one if necessary. Does nothing if an activation is already on its way, since that one will serve this caller too.
+ */
+- (void)activateWindowInCurrentSpace;
+
+/**
+ * Forgets the windows of the space that was left, and fills the pool for the new space once it has stayed there for SPS_WINDOW_POOL_DELAY.
+ */
+- (void)activeSpaceDidChange;
+
+/**
+ * Adds a window Safari has made to the index, unless it is a pooled window or may turn out to be one.
+ */
+- (void)windowWasCreated:(NSInteger)windowIdentifier;
+
+/**
+ * Forgets a window Safari has closed.
+ */
+- (void)windowWasDestroyed:(NSInteger)windowIdentifier;
+
+/**
+ * Tells the driver which window has come in front of Safari's others.
+ */
+- (void)windowDidComeToFront:(NSInteger)windowIdentifier;
+
+/**
+ * Forgets which windows there are and which of them is in front, because window changes may have been missed.
+ */
+- (void)windowsDidGoUnobserved;
+
+/**
+ * Forgets everything about Safari, which has exited, so that the next URL goes straight to launching it.
+ */
+- (void)safariDidExit;
+
+/**
+ * Stops calling the delegate, and stops flushing, filling the pool and evicting from it. Jobs that were already queued still run. Must be called before the delegate goes away.
+ */
+- (void)invalidate;
+
+@end
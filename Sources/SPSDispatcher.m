@@ -0,0 +1,444 @@
+//
+//  SPSDispatcher.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSDispatcher.h"
+#import "SPSSafariDriver.h"
+#import "SPSSpaceWindowIndex.h"
+#import "SPSCoalescer.h"
+#import "SPSWindowPool.h"
+#import "SPSURLRequest.h"
+#import "SPSMetrics.h"
+
+
+@interface SPSDispatcher ()
+
+/**
+ * Returns the current time by the clock of the dispatcher.
+ */
+- (NSTimeInterval)currentTime;
+
+/**
+ * Hands a job to the executor.
+ *
+ * @return Whether the job was queued.
+ */
+- (BOOL)enqueueJob:(void (^)(void))job;
+
+/**
+ * Calls the given block on the main thread after the given delay, unless the dispatcher has been invalidated by then. May be called from a job.
+ */
+- (void)performOnMainThreadAfterDelay:(NSTimeInterval)delay action:(void (^)(void))action;
+
+/**
+ * Schedules the pending URLs to be flushed when they are due, replacing any previously scheduled flush.
+ */
+- (void)scheduleURLFlush;
+
+/**
+ * Opens the pending URLs as one batch.
+ */
+- (void)flushURLs;
+
+/**
+ * Makes a window for the pool in the current space, if it has no Safari window and the pool has none for it.
+ */
+- (void)fillWindowPool;
+
+/**
+ * Schedules the pooled windows that will have gone unclaimed for too long to be closed, replacing any previously scheduled eviction.
+ */
+- (void)scheduleEviction;
+
+/**
+ * Closes the pooled windows that have gone unclaimed for too long.
+ */
+- (void)evictIdlePoolWindows;
+
+/**
+ * Takes the pooled window of the current space, if a window has to be made there anyway.
+ *
+ * @param windowIdentifier The target window in the current space, as returned by the delegate.
+ * @return A pooled window, or 0 if there is none or none is needed.
+ */
+- (NSInteger)claimPooledWindowForTargetWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Passes on what was seen of Safari's windows to the driver, on the executor. If the executor is too far behind to take it, the driver forgets what it knows about Safari instead.
+ *
+ * @param block A block that tells the driver, may not be nil.
+ */
+- (void)tellSafariDriver:(void (^)(SPSSafariDriver *driver))block;
+
+/**
+ * Marks the start of an activation, unless one is already in flight.
+ *
+ * @return YES if the caller should perform the activation, or NO if it shares the one in flight.
+ */
+- (BOOL)beginActivation;
+
+/**
+ * Marks the end of the activation in flight.
+ */
+- (void)endActivation;
+
+@end
+
+
+@implementation SPSDispatcher
+
+@synthesize clock;
+@synthesize executor;
+@synthesize scheduler;
+
+- (id)initWithSafariDriver:(SPSSafariDriver *)aSafariDriver spaceWindowIndex:(SPSSpaceWindowIndex *)aSpaceWindowIndex coalescer:(SPSCoalescer *)aCoalescer windowPool:(SPSWindowPool *)aWindowPool delegate:(id <SPSDispatcherDelegate>)aDelegate {
+	if ((self = [super init])) {
+		safariDriver = [aSafariDriver retain];
+		spaceWindowIndex = [aSpaceWindowIndex retain];
+		coalescer = [aCoalescer retain];
+		windowPool = [aWindowPool retain];
+		delegate = aDelegate;
+		windowsCreatedWhilePooling = [[NSMutableSet alloc] init];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[safariDriver release];
+	[spaceWindowIndex release];
+	[coalescer release];
+	[windowPool release];
+	[windowsCreatedWhilePooling release];
+	[clock release];
+	[executor release];
+	[scheduler release];
+	[super dealloc];
+}
+
+- (void)openRequest:(SPSURLRequest *)request {
+	// Collect URLs arriving in a burst, so that Safari is only activated once for all of them
+	[coalescer addObject:request atTime:[self currentTime]];
+	[self scheduleURLFlush];
+}
+
+- (void)activateWindowInCurrentSpace {
+	if (![self beginActivation]) {
+		return;
+	}
+	
+	pid_t processIdentifier = [delegate safariProcessIdentifierForDispatcher:self];
+	NSInteger windowIdentifier = [delegate dispatcher:self targetWindowIdentifierWithProcessIdentifier:processIdentifier];
+	NSInteger pooledWindowIdentifier = [self claimPooledWindowForTargetWindow:windowIdentifier];
+	SPSSafariDriver *driver = safariDriver;
+	
+	BOOL queued = [self enqueueJob:^{
+		if (pooledWindowIdentifier > 0) {
+			[driver claimPooledWindow:pooledWindowIdentifier];
+		}
+		[driver activateWindowInCurrentSpaceWithProcessIdentifier:processIdentifier windowIdentifier:windowIdentifier];
+		
+		[self performOnMainThreadAfterDelay:0.0 action:^{
+			[self endActivation];
+		}];
+	}];
+	
+	if (!queued) {
+		[self endActivation];
+	}
+}
+
+- (void)activeSpaceDidChange {
+	// Windows in the new space have not been seen yet, and the window in front of Safari's may be in another space now
+	[spaceWindowIndex invalidate];
+	[self tellSafariDriver:^(SPSSafariDriver *driver) {
+		[driver forgetFrontWindow];
+	}];
+	
+	if (windowPool != nil) {
+		NSUInteger generation = ++fillGeneration;
+		[self performOnMainThreadAfterDelay:SPS_WINDOW_POOL_DELAY action:^{
+			if (generation == fillGeneration) {
+				[self fillWindowPool];
+			}
+		}];
+	}
+}
+
+- (void)windowWasCreated:(NSInteger)windowIdentifier {
+	// Pooled windows are miniaturized, so they are not windows to send URLs to
+	if ([windowPool containsWindow:windowIdentifier]) {
+		return;
+	}
+	
+	// The notification for a pooled window can come before the pool knows which window it is
+	if ([windowPool isMakingWindow]) {
+		[windowsCreatedWhilePooling addObject:[NSNumber numberWithInteger:windowIdentifier]];
+		return;
+	}
+	
+	// A new window comes in front of Safari's other windows
+	[spaceWindowIndex addWindowIdentifier:windowIdentifier];
+	[self tellSafariDriver:^(SPSSafariDriver *driver) {
+		[driver noteFrontWindow:windowIdentifier];
+	}];
+}
+
+- (void)windowWasDestroyed:(NSInteger)windowIdentifier {
+	[windowsCreatedWhilePooling removeObject:[NSNumber numberWithInteger:windowIdentifier]];
+	[spaceWindowIndex removeWindowIdentifier:windowIdentifier];
+	[windowPool removeWindow:windowIdentifier];
+	[self tellSafariDriver:^(SPSSafariDriver *driver) {
+		[driver noteClosedWindow:windowIdentifier];
+	}];
+}
+
+- (void)windowDidComeToFront:(NSInteger)windowIdentifier {
+	[self tellSafariDriver:^(SPSSafariDriver *driver) {
+		[driver noteFrontWindow:windowIdentifier];
+	}];
+}
+
+- (void)windowsDidGoUnobserved {
+	[spaceWindowIndex invalidate];
+	[self tellSafariDriver:^(SPSSafariDriver *driver) {
+		[driver forgetFrontWindow];
+	}];
+}
+
+- (void)safariDidExit {
+	[spaceWindowIndex refreshWithProcessIdentifier:0 atTime:[self currentTime]];
+	[windowPool removeAllWindows];
+	[windowsCreatedWhilePooling removeAllObjects];
+	[safariDriver invalidateState];
+}
+
+- (void)invalidate {
+	invalidated = YES;
+	delegate = nil;
+}
+
+#pragma mark SPSDispatcher
+
+- (NSTimeInterval)currentTime {
+	NSTimeInterval (^currentClock)(void) = [self clock];
+	return (currentClock != nil) ? currentClock() : [NSDate timeIntervalSinceReferenceDate];
+}
+
+- (BOOL)enqueueJob:(void (^)(void))job {
+	BOOL (^currentExecutor)(void (^)(void)) = [self executor];
+	return (currentExecutor != nil && !invalidated && currentExecutor(job));
+}
+
+- (void)performOnMainThreadAfterDelay:(NSTimeInterval)delay action:(void (^)(void))action {
+	// The action keeps the dispatcher around until it has been called, and then does nothing if the dispatcher was invalidated meanwhile
+	void (^guardedAction)(void) = ^{
+		if (!invalidated) {
+			action();
+		}
+	};
+	
+	void (^currentScheduler)(NSTimeInterval, void (^)(void)) = [self scheduler];
+	if (currentScheduler != nil) {
+		currentScheduler(delay, guardedAction);
+	}
+	else if (delay > 0.0) {
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), guardedAction);
+	}
+	else {
+		dispatch_async(dispatch_get_main_queue(), guardedAction);
+	}
+}
+
+- (void)scheduleURLFlush {
+	NSTimeInterval delay = MAX([coalescer dueTime] - [self currentTime], 0.0);
+	
+	// Only the flush scheduled last goes ahead
+	NSUInteger generation = ++flushGeneration;
+	[self performOnMainThreadAfterDelay:delay action:^{
+		if (generation == flushGeneration) {
+			[self flushURLs];
+		}
+	}];
+}
+
+- (void)flushURLs {
+	NSArray *requests = [coalescer flushAtTime:[self currentTime]];
+	
+	if ([requests count] > 0) {
+		// An activation that is still queued or running comes before this batch, so the batch can share it
+		BOOL activate = [self beginActivation];
+		pid_t processIdentifier = [delegate safariProcessIdentifierForDispatcher:self];
+		NSInteger windowIdentifier = [delegate dispatcher:self targetWindowIdentifierWithProcessIdentifier:processIdentifier];
+		
+		// A batch can ask for a window of its own, such as when the window it would go to has been filled up. The driver makes it even if the batch shares an activation
+		if ([[requests objectAtIndex:0] opensInNewWindow] && windowIdentifier != SPS_UNKNOWN_WINDOW) {
+			windowIdentifier = SPS_NO_WINDOW;
+		}
+		
+		NSInteger pooledWindowIdentifier = activate ? [self claimPooledWindowForTargetWindow:windowIdentifier] : 0;
+		SPSSafariDriver *driver = safariDriver;
+		
+		BOOL queued = [self enqueueJob:^{
+			if (pooledWindowIdentifier > 0) {
+				[driver claimPooledWindow:pooledWindowIdentifier];
+			}
+			[driver dispatchRequests:requests withProcessIdentifier:processIdentifier windowIdentifier:windowIdentifier activatingWindow:activate];
+			
+			// Apple Events can only be resumed on the main thread
+			[self performOnMainThreadAfterDelay:0.0 action:^{
+				if (activate) {
+					[self endActivation];
+				}
+				
+				// Send the next URLs in this space to the same window
+				NSInteger usedWindowIdentifier = [[requests objectAtIndex:0] windowIdentifier];
+				if (usedWindowIdentifier > 0) {
+					[spaceWindowIndex noteWindowUsed:usedWindowIdentifier];
+				}
+				
+				[delegate dispatcher:self didDispatchRequests:requests];
+			}];
+		}];
+		
+		// The executor is far behind, so these URLs would not make their deadline either
+		if (!queued) {
+			if (activate) {
+				[self endActivation];
+			}
+			
+			for (SPSURLRequest *request in requests) {
+				[request setError:[NSError errorWithDomain:NSOSStatusErrorDomain code:errAETimeout userInfo:nil]];
+			}
+			[delegate dispatcher:self didDispatchRequests:requests];
+		}
+	}
+}
+
+- (void)fillWindowPool {
+	pid_t processIdentifier = [delegate safariProcessIdentifierForDispatcher:self];
+	if (processIdentifier == 0) {
+		return;
+	}
+	
+	[self evictIdlePoolWindows];
+	
+	NSInteger windowIdentifier = [delegate dispatcher:self targetWindowIdentifierWithProcessIdentifier:processIdentifier];
+	NSInteger spaceIdentifier = [spaceWindowIndex activeSpaceIdentifier];
+	if (windowIdentifier != SPS_NO_WINDOW || ![windowPool shouldMakeWindowForSpace:spaceIdentifier]) {
+		return;
+	}
+	
+	[windowPool beginMakingWindowForSpace:spaceIdentifier];
+	SPSSafariDriver *driver = safariDriver;
+	
+	BOOL queued = [self enqueueJob:^{
+		int64_t byteCount = 0;
+		NSInteger pooledWindowIdentifier = [driver makePooledWindowWithProcessIdentifier:processIdentifier byteCount:&byteCount];
+		
+		[self performOnMainThreadAfterDelay:0.0 action:^{
+			if (pooledWindowIdentifier > 0) {
+				[windowPool addWindow:pooledWindowIdentifier forSpace:spaceIdentifier byteCount:byteCount atTime:[self currentTime]];
+				[spaceWindowIndex removeWindowIdentifier:pooledWindowIdentifier];
+			}
+			else {
+				[windowPool cancelMakingWindowForSpace:spaceIdentifier];
+			}
+			
+			// Windows that were created meanwhile were held back, since one of them may have been the pooled window
+			[windowsCreatedWhilePooling removeObject:[NSNumber numberWithInteger:pooledWindowIdentifier]];
+			if (![windowPool isMakingWindow]) {
+				for (NSNumber *createdWindowIdentifier in windowsCreatedWhilePooling) {
+					[spaceWindowIndex addWindowIdentifier:[createdWindowIdentifier integerValue]];
+				}
+				
+				// It is not known which of them came in front last
+				if ([windowsCreatedWhilePooling count] > 0) {
+					[self tellSafariDriver:^(SPSSafariDriver *driver) {
+						[driver forgetFrontWindow];
+					}];
+				}
+				[windowsCreatedWhilePooling removeAllObjects];
+			}
+			
+			[self scheduleEviction];
+		}];
+	}];
+	
+	// No window is on its way after all
+	if (!queued) {
+		[windowPool cancelMakingWindowForSpace:spaceIdentifier];
+	}
+}
+
+- (void)scheduleEviction {
+	NSUInteger generation = ++evictionGeneration;
+	[self performOnMainThreadAfterDelay:[windowPool idleTimeout] action:^{
+		if (generation == evictionGeneration) {
+			[self evictIdlePoolWindows];
+		}
+	}];
+}
+
+- (void)evictIdlePoolWindows {
+	NSArray *windowIdentifiers = [windowPool evictIdleWindowsAtTime:[self currentTime]];
+	SPSSafariDriver *driver = safariDriver;
+	
+	// A window that cannot be closed now is out of the pool anyway, and the user can close it
+	for (NSNumber *windowIdentifier in windowIdentifiers) {
+		[self enqueueJob:^{
+			[driver closeWindow:[windowIdentifier integerValue]];
+		}];
+	}
+}
+
+- (NSInteger)claimPooledWindowForTargetWindow:(NSInteger)windowIdentifier {
+	if (windowIdentifier != SPS_NO_WINDOW) {
+		return 0;
+	}
+	return [windowPool claimWindowForSpace:[spaceWindowIndex activeSpaceIdentifier]];
+}
+
+- (void)tellSafariDriver:(void (^)(SPSSafariDriver *driver))block {
+	SPSSafariDriver *driver = safariDriver;
+	
+	BOOL queued = [self enqueueJob:^{
+		block(driver);
+	}];
+	if (!queued) {
+		[driver invalidateState];
+	}
+}
+
+- (BOOL)beginActivation {
+	if (activationInFlight) {
+		SPSCounterAdd(SPSCounterJoinedActivations, 1);
+		return NO;
+	}
+	
+	SPSCounterAdd(SPSCounterActivations, 1);
+	activationInFlight = YES;
+	return YES;
+}
+
+- (void)endActivation {
+	activationInFlight = NO;
+}
+
+@end
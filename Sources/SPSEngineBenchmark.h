@@ -0,0 +1,74 @@
+//
+//  SPSEngineBenchmark.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import "SPSScriptingEngine.h"
+
+
+/**
+ * The number of rounds the engine benchmark runs when none is given.
+ */
+#define SPS_ENGINE_BENCHMARK_ROUNDS 50
+
+/**
+ * The time each round of the engine benchmark is given before its commands fail, in seconds.
+ */
+#define SPS_ENGINE_BENCHMARK_ROUND_TIMEOUT 10.0
+
+
+/**
+ * Sends the same sequence of commands to the real Safari through ScriptingBridge and through raw Apple Events, and compares how long each command takes.
+ *
+ * Every round makes a blank window of its own, asks which window is in front, counts its tabs, points its tab at about:blank, raises it, counts the windows of Safari in the current space and closes the window again, so that the windows of the user are left alone. Both engines run every round, and which one goes first alternates, so that neither is favored by a warm cache.
+ *
+ * Handing over URLs is left out: both engines hand them to Launch Services in the same way.
+ *
+ * The median and the 99th percentile of every command are written to standard output for each engine, as well as the number of commands that failed.
+ */
+@interface SPSEngineBenchmark : NSObject <SPSScriptingEngineDelegate> {
+	NSArray *engines;
+	NSArray *engineNames;
+	NSUInteger roundCount;
+	NSUInteger currentEngineIndex;
+	NSMutableArray *durations;
+	NSCountedSet *failedEngineNames;
+}
+
+/**
+ * Returns the names of the commands of a round, in the order they are sent.
+ */
++ (NSArray *)commandNames;
+
+/**
+ * Initializes the benchmark with an engine of each kind.
+ *
+ * @param rounds The number of times the sequence is sent through each engine.
+ */
+- (id)initWithRounds:(NSUInteger)rounds;
+
+/**
+ * Runs every round, on the calling thread, and writes the results.
+ *
+ * @return Whether Safari could be scripted through both engines.
+ */
+- (BOOL)run;
+
+@end
@@ -0,0 +1,205 @@
+//
+//  SPSEngineBenchmark.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSEngineBenchmark.h"
+#import "SPSScriptingBridgeEngine.h"
+#import "SPSAppleEventEngine.h"
+#import "SPSSafariDriver.h"
+
+
+@interface SPSEngineBenchmark ()
+
+/**
+ * Sends a round of commands through the given engine.
+ *
+ * @return Whether Safari was running and made a window.
+ */
+- (BOOL)runRoundWithEngineAtIndex:(NSUInteger)engineIndex;
+
+/**
+ * Runs the given block, which sends a single command, and adds how long it took to the durations of the command.
+ */
+- (void)measureCommand:(NSString *)commandName withBlock:(void (^)(void))block;
+
+/**
+ * Returns the duration below which the given fraction of the sorted durations lies, by nearest rank, in microseconds.
+ */
++ (long long)percentile:(double)fraction ofSortedDurations:(NSArray *)sortedDurations;
+
+@end
+
+
+@implementation SPSEngineBenchmark
+
++ (NSArray *)commandNames {
+	return [NSArray arrayWithObjects:@"activate", @"make_document", @"front_window", @"count_tabs", @"set_url", @"raise_window", @"count_process_windows", @"close_window", nil];
+}
+
+- (id)initWithRounds:(NSUInteger)rounds {
+	if ((self = [super init])) {
+		SPSScriptingBridgeEngine *scriptingBridgeEngine = [[SPSScriptingBridgeEngine alloc] init];
+		SPSAppleEventEngine *appleEventEngine = [[SPSAppleEventEngine alloc] init];
+		engines = [[NSArray alloc] initWithObjects:scriptingBridgeEngine, appleEventEngine, nil];
+		engineNames = [[NSArray alloc] initWithObjects:@"scriptingbridge", @"appleevents", nil];
+		[scriptingBridgeEngine release];
+		[appleEventEngine release];
+		
+		roundCount = rounds;
+		
+		durations = [[NSMutableArray alloc] initWithCapacity:[engines count]];
+		for (id <SPSScriptingEngine> engine in engines) {
+			[engine setDelegate:self];
+			[durations addObject:[NSMutableDictionary dictionary]];
+		}
+		
+		failedEngineNames = [[NSCountedSet alloc] init];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	for (id <SPSScriptingEngine> engine in engines) {
+		[engine setDelegate:nil];
+	}
+	
+	[engines release];
+	[engineNames release];
+	[durations release];
+	[failedEngineNames release];
+	[super dealloc];
+}
+
+- (BOOL)run {
+	for (NSUInteger round = 0; round < roundCount; round++) {
+		// Alternate which engine goes first, so that the second does not always find Safari warmed up by the first
+		for (NSUInteger offset = 0; offset < [engines count]; offset++) {
+			NSUInteger engineIndex = (round + offset) % [engines count];
+			
+			NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+			BOOL succeeded = [self runRoundWithEngineAtIndex:engineIndex];
+			[pool release];
+			
+			if (!succeeded) {
+				fprintf(stderr, "Could not script Safari through %s\n", [[engineNames objectAtIndex:engineIndex] UTF8String]);
+				return NO;
+			}
+		}
+	}
+	
+	printf("rounds %lu\n", (unsigned long)roundCount);
+	for (NSUInteger engineIndex = 0; engineIndex < [engines count]; engineIndex++) {
+		NSString *engineName = [engineNames objectAtIndex:engineIndex];
+		
+		for (NSString *commandName in [[self class] commandNames]) {
+			NSArray *sortedDurations = [[[durations objectAtIndex:engineIndex] objectForKey:commandName] sortedArrayUsingSelector:@selector(compare:)];
+			printf("%s_%s_p50_microseconds %lld\n", [engineName UTF8String], [commandName UTF8String], [[self class] percentile:0.50 ofSortedDurations:sortedDurations]);
+			printf("%s_%s_p99_microseconds %lld\n", [engineName UTF8String], [commandName UTF8String], [[self class] percentile:0.99 ofSortedDurations:sortedDurations]);
+		}
+		
+		printf("%s_failed_commands %lu\n", [engineName UTF8String], (unsigned long)[failedEngineNames countForObject:engineName]);
+	}
+	fflush(stdout);
+	
+	return YES;
+}
+
+#pragma mark SPSEngineBenchmark
+
+- (BOOL)runRoundWithEngineAtIndex:(NSUInteger)engineIndex {
+	id <SPSScriptingEngine> engine = [engines objectAtIndex:engineIndex];
+	currentEngineIndex = engineIndex;
+	[engine setDeadline:[NSDate timeIntervalSinceReferenceDate] + SPS_ENGINE_BENCHMARK_ROUND_TIMEOUT];
+	
+	[self measureCommand:@"activate" withBlock:^{
+		[engine activate];
+	}];
+	
+	NSRunningApplication *safari = [[NSRunningApplication runningApplicationsWithBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER] lastObject];
+	if (safari == nil) {
+		return NO;
+	}
+	
+	[self measureCommand:@"make_document" withBlock:^{
+		[engine makeDocumentWithURL:nil];
+	}];
+	
+	__block NSInteger windowIdentifier = 0;
+	[self measureCommand:@"front_window" withBlock:^{
+		windowIdentifier = [engine frontWindowIdentifier];
+	}];
+	if (windowIdentifier == 0) {
+		return NO;
+	}
+	
+	[self measureCommand:@"count_tabs" withBlock:^{
+		[engine countOfTabsInWindow:windowIdentifier];
+	}];
+	
+	[self measureCommand:@"set_url" withBlock:^{
+		[engine setURL:[NSURL URLWithString:@"about:blank"] ofTab:1 inWindow:windowIdentifier];
+	}];
+	
+	[self measureCommand:@"raise_window" withBlock:^{
+		[engine raiseWindow:windowIdentifier];
+	}];
+	
+	[self measureCommand:@"count_process_windows" withBlock:^{
+		[engine countOfWindowsOfProcessWithIdentifier:[safari processIdentifier]];
+	}];
+	
+	[self measureCommand:@"close_window" withBlock:^{
+		[engine closeWindow:windowIdentifier];
+	}];
+	
+	return YES;
+}
+
+- (void)measureCommand:(NSString *)commandName withBlock:(void (^)(void))block {
+	NSTimeInterval startTime = [NSDate timeIntervalSinceReferenceDate];
+	block();
+	NSTimeInterval duration = [NSDate timeIntervalSinceReferenceDate] - startTime;
+	
+	NSMutableDictionary *engineDurations = [durations objectAtIndex:currentEngineIndex];
+	NSMutableArray *commandDurations = [engineDurations objectForKey:commandName];
+	if (commandDurations == nil) {
+		commandDurations = [NSMutableArray arrayWithCapacity:roundCount];
+		[engineDurations setObject:commandDurations forKey:commandName];
+	}
+	[commandDurations addObject:[NSNumber numberWithDouble:duration]];
+}
+
++ (long long)percentile:(double)fraction ofSortedDurations:(NSArray *)sortedDurations {
+	NSUInteger count = [sortedDurations count];
+	if (count == 0) {
+		return 0;
+	}
+	
+	NSUInteger index = (NSUInteger)ceil(fraction * count) - 1;
+	return (long long)([[sortedDurations objectAtIndex:MIN(index, count - 1)] doubleValue] * 1000000.0);
+}
+
+#pragma mark SPSScriptingEngineDelegate
+
+- (void)scriptingEngine:(id <SPSScriptingEngine>)engine didFailWithError:(NSError *)error {
+	[failedEngineNames addObject:[engineNames objectAtIndex:currentEngineIndex]];
+}
+
+@end
@@ -0,0 +1,59 @@
+//
+//  SPSEventLogReader.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import "SPSEventRecorder.h"
+
+
+/**
+ * Reads an event log written by SPSEventRecorder, through a memory mapping.
+ */
+@interface SPSEventLogReader : NSObject {
+	NSData *recordData;
+	NSArray *URLStrings;
+}
+
+/**
+ * Initializes the reader.
+ *
+ * @param path The path of the log, may not be nil.
+ * @return The reader, or nil if the log or its URLs could not be read.
+ */
+- (id)initWithPath:(NSString *)path;
+
+/**
+ * The number of events in the log.
+ */
+- (NSUInteger)count;
+
+/**
+ * The time at which the log starts.
+ */
+- (NSTimeInterval)startTime;
+
+/**
+ * Calls the given block for every event in the log, in the order in which they were recorded.
+ *
+ * @param block A block that is given the record and its URL, or nil if it has none.
+ */
+- (void)enumerateEventsUsingBlock:(void (^)(const SPSEventRecord *record, NSString *URLString))block;
+
+@end
@@ -0,0 +1,116 @@
+//
+//  SPSEventLogReader.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSEventLogReader.h"
+
+
+@interface SPSEventLogReader ()
+
+/**
+ * Returns the header of the log.
+ */
+- (const SPSEventLogHeader *)header;
+
+@end
+
+
+@implementation SPSEventLogReader
+
+- (id)initWithPath:(NSString *)path {
+	if ((self = [super init])) {
+		recordData = [[NSData alloc] initWithContentsOfFile:path options:NSDataReadingMapped error:NULL];
+		NSData *URLData = [NSData dataWithContentsOfFile:[path stringByAppendingPathExtension:SPS_EVENT_LOG_URLS_EXTENSION] options:NSDataReadingMapped error:NULL];
+		
+		// A log that was not closed is longer than its header says, but never shorter
+		const SPSEventLogHeader *header = [self header];
+		if (header == NULL || header->magic != SPS_EVENT_LOG_MAGIC || header->version != SPS_EVENT_LOG_VERSION || [recordData length] < sizeof(SPSEventLogHeader) + header->count * sizeof(SPSEventRecord)) {
+			[self release];
+			return nil;
+		}
+		
+		const SPSEventLogHeader *URLHeader = ([URLData length] >= sizeof(SPSEventLogHeader)) ? [URLData bytes] : NULL;
+		if (URLHeader == NULL || URLHeader->magic != SPS_EVENT_LOG_URLS_MAGIC || URLHeader->version != SPS_EVENT_LOG_VERSION) {
+			[self release];
+			return nil;
+		}
+		
+		NSMutableArray *someURLStrings = [NSMutableArray arrayWithCapacity:URLHeader->count];
+		const uint8_t *bytes = [URLData bytes];
+		size_t offset = sizeof(SPSEventLogHeader);
+		for (uint32_t index = 0; index < URLHeader->count; index++) {
+			if (offset + sizeof(uint32_t) > [URLData length]) {
+				break;
+			}
+			
+			uint32_t length = *(const uint32_t *)(bytes + offset);
+			if (offset + sizeof(uint32_t) + length > [URLData length]) {
+				break;
+			}
+			
+			NSString *URLString = [[NSString alloc] initWithBytes:bytes + offset + sizeof(uint32_t) length:length encoding:NSUTF8StringEncoding];
+			[someURLStrings addObject:(URLString != nil) ? URLString : @""];
+			[URLString release];
+			
+			offset += sizeof(uint32_t) + ((length + 3) & ~(size_t)3);
+		}
+		URLStrings = [someURLStrings copy];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[recordData release];
+	[URLStrings release];
+	[super dealloc];
+}
+
+- (NSUInteger)count {
+	return [self header]->count;
+}
+
+- (NSTimeInterval)startTime {
+	return [self header]->startTime / 1000000.0;
+}
+
+- (void)enumerateEventsUsingBlock:(void (^)(const SPSEventRecord *record, NSString *URLString))block {
+	const SPSEventLogHeader *header = [self header];
+	const SPSEventRecord *records = (const SPSEventRecord *)((const uint8_t *)header + sizeof(SPSEventLogHeader));
+	
+	for (uint32_t index = 0; index < header->count; index++) {
+		const SPSEventRecord *record = &records[index];
+		
+		// URLs that could not be written to the URL file are left out
+		NSString *URLString = nil;
+		if (record->URLIdentifier > 0 && record->URLIdentifier <= [URLStrings count]) {
+			URLString = [URLStrings objectAtIndex:record->URLIdentifier - 1];
+		}
+		
+		block(record, URLString);
+	}
+}
+
+#pragma mark SPSEventLogReader
+
+- (const SPSEventLogHeader *)header {
+	return ([recordData length] >= sizeof(SPSEventLogHeader)) ? [recordData bytes] : NULL;
+}
+
+@end
@@ -0,0 +1,136 @@
+//
+//  SPSEventRecorder.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ * The user defaults key of the path to record URL and activation events to, if any.
+ */
+#define SPS_RECORD_EVENTS_DEFAULT @"RecordEvents"
+
+/**
+ * The extension of event logs. The interned URLs are kept next to the log, in a file with SPS_EVENT_LOG_URLS_EXTENSION appended.
+ */
+#define SPS_EVENT_LOG_EXTENSION @"spslog"
+#define SPS_EVENT_LOG_URLS_EXTENSION @"urls"
+
+#define SPS_EVENT_LOG_MAGIC 0x5350534C
+#define SPS_EVENT_LOG_URLS_MAGIC 0x53505355
+#define SPS_EVENT_LOG_VERSION 1
+
+
+/**
+ * The kinds of recorded events.
+ */
+typedef enum {
+	SPSEventTypeURL = 1,
+	SPSEventTypeActivation = 2
+} SPSEventType;
+
+/**
+ * The start of an event log, and of the file with its URLs.
+ */
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t count;
+	uint32_t reserved;
+	int64_t startTime;
+} SPSEventLogHeader;
+
+/**
+ * A recorded event. Events follow the header of the log, in the byte order of the recording machine.
+ */
+typedef struct {
+	int64_t time;
+	uint32_t URLIdentifier;
+	int32_t spaceIdentifier;
+	uint32_t URLLength;
+	uint16_t type;
+	uint16_t reserved;
+} SPSEventRecord;
+
+
+/**
+ * A file that is written through a shared memory mapping, which is grown by doubling.
+ */
+typedef struct {
+	int fileDescriptor;
+	uint8_t *bytes;
+	size_t capacity;
+} SPSMappedFile;
+
+
+/**
+ * An interned URL: the hash of its bytes, where its entry starts in the URL file, and its identifier.
+ */
+typedef struct {
+	uint64_t hash;
+	uint64_t offset;
+	uint32_t identifier;
+	uint32_t reserved;
+} SPSInternedURL;
+
+
+/**
+ * Appends events to a memory-mapped log, for replaying them later with SPSEventLogReader.
+ *
+ * Every event is a fixed-size SPSEventRecord, with times in microseconds since the start of the log. URLs are interned: each distinct URL is written to the URL file once, and events refer to it by its one-based position there.
+ *
+ * Recording an event only writes to mapped memory, and the files are only resized when they are full, so that events that come in all the time cost neither allocations nor system calls. The URL of an event is written to the end of the URL file and looked up by the hash of its bytes in a table of fixed size, and is only kept there if it was not found. Once the slots a URL can go to are taken, the one it hashes to is reused, so a URL that was pushed out of the table is written again under a new identifier.
+ *
+ * A recorder may only be used from the main thread.
+ */
+@interface SPSEventRecorder : NSObject {
+	SPSMappedFile recordFile;
+	SPSMappedFile URLFile;
+	size_t URLFileLength;
+	SPSInternedURL *internedURLs;
+	NSTimeInterval startTime;
+	BOOL failed;
+}
+
+/**
+ * Initializes the recorder, replacing any log at the given path.
+ *
+ * @param path The path of the log, may not be nil.
+ * @param time The time at which the log starts.
+ * @return The recorder, or nil if the log could not be created.
+ */
+- (id)initWithPath:(NSString *)path startTime:(NSTimeInterval)time;
+
+/**
+ * Appends an event to the log. Once the log cannot be grown any further, events are dropped.
+ *
+ * @param type The kind of event.
+ * @param URLString The URL of the event, or nil if it has none.
+ * @param spaceIdentifier The active space at the time of the event.
+ * @param time The time of the event.
+ */
+- (void)recordEventOfType:(SPSEventType)type URLString:(NSString *)URLString spaceIdentifier:(NSInteger)spaceIdentifier atTime:(NSTimeInterval)time;
+
+/**
+ * Trims the files to what has been recorded and closes them. Nothing is recorded afterwards.
+ */
+- (void)close;
+
+@end
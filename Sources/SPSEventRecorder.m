@@ -0,0 +1,249 @@
+//
+//  SPSEventRecorder.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSEventRecorder.h"
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+/**
+ * The initial size of the files, in bytes.
+ */
+#define SPS_EVENT_LOG_INITIAL_CAPACITY (64 * 1024)
+
+/**
+ * The number of slots of the table of interned URLs, a power of two, and how many slots from the one it hashes to a URL may be put in.
+ */
+#define SPS_INTERNED_URL_CAPACITY 4096
+#define SPS_INTERNED_URL_PROBE_LIMIT 8
+
+
+/**
+ * Creates a file of the given size and maps it. Returns NO if this failed, in which case the file is not open.
+ */
+static BOOL SPSMappedFileOpen(SPSMappedFile *file, const char *path, size_t capacity) {
+	file->fileDescriptor = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	file->bytes = NULL;
+	file->capacity = 0;
+	
+	if (file->fileDescriptor == -1) {
+		return NO;
+	}
+	
+	void *bytes = MAP_FAILED;
+	if (ftruncate(file->fileDescriptor, capacity) == 0) {
+		bytes = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, file->fileDescriptor, 0);
+	}
+	if (bytes == MAP_FAILED) {
+		close(file->fileDescriptor);
+		file->fileDescriptor = -1;
+		return NO;
+	}
+	
+	file->bytes = bytes;
+	file->capacity = capacity;
+	return YES;
+}
+
+/**
+ * Makes sure that the first length bytes of the file are mapped, growing it if necessary. Returns NO if the file could not be grown, in which case it is left as it was.
+ */
+static BOOL SPSMappedFileReserve(SPSMappedFile *file, size_t length) {
+	if (length <= file->capacity) {
+		return YES;
+	}
+	
+	size_t capacity = file->capacity;
+	while (capacity < length) {
+		capacity *= 2;
+	}
+	
+	if (ftruncate(file->fileDescriptor, capacity) != 0) {
+		return NO;
+	}
+	void *bytes = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, file->fileDescriptor, 0);
+	if (bytes == MAP_FAILED) {
+		return NO;
+	}
+	
+	munmap(file->bytes, file->capacity);
+	file->bytes = bytes;
+	file->capacity = capacity;
+	return YES;
+}
+
+/**
+ * Unmaps the file and trims it to the given length.
+ */
+static void SPSMappedFileClose(SPSMappedFile *file, size_t length) {
+	if (file->fileDescriptor == -1) {
+		return;
+	}
+	
+	munmap(file->bytes, file->capacity);
+	ftruncate(file->fileDescriptor, length);
+	close(file->fileDescriptor);
+	
+	file->fileDescriptor = -1;
+	file->bytes = NULL;
+	file->capacity = 0;
+}
+
+/**
+ * Returns the 64-bit FNV-1a hash of the given bytes.
+ */
+static uint64_t SPSHashBytes(const uint8_t *bytes, size_t length) {
+	uint64_t hash = 14695981039346656037ULL;
+	for (size_t position = 0; position < length; position++) {
+		hash = (hash ^ bytes[position]) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+
+@interface SPSEventRecorder ()
+
+/**
+ * Returns the identifier of the given URL, keeping it in the URL file if it is not in the table of interned URLs, or 0 if it could not be written.
+ */
+- (uint32_t)identifierOfURLString:(NSString *)URLString length:(NSUInteger)length;
+
+@end
+
+
+@implementation SPSEventRecorder
+
+- (id)initWithPath:(NSString *)path startTime:(NSTimeInterval)time {
+	if ((self = [super init])) {
+		recordFile.fileDescriptor = -1;
+		URLFile.fileDescriptor = -1;
+		
+		NSString *URLPath = [path stringByAppendingPathExtension:SPS_EVENT_LOG_URLS_EXTENSION];
+		if (!SPSMappedFileOpen(&recordFile, [path fileSystemRepresentation], SPS_EVENT_LOG_INITIAL_CAPACITY) || !SPSMappedFileOpen(&URLFile, [URLPath fileSystemRepresentation], SPS_EVENT_LOG_INITIAL_CAPACITY)) {
+			[self release];
+			return nil;
+		}
+		
+		startTime = time;
+		
+		// The counts in the headers only ever cover complete entries, so that a log that was not closed can still be read
+		SPSEventLogHeader *recordHeader = (SPSEventLogHeader *)recordFile.bytes;
+		recordHeader->magic = SPS_EVENT_LOG_MAGIC;
+		recordHeader->version = SPS_EVENT_LOG_VERSION;
+		recordHeader->startTime = (int64_t)(time * 1000000.0);
+		
+		SPSEventLogHeader *URLHeader = (SPSEventLogHeader *)URLFile.bytes;
+		URLHeader->magic = SPS_EVENT_LOG_URLS_MAGIC;
+		URLHeader->version = SPS_EVENT_LOG_VERSION;
+		URLHeader->startTime = recordHeader->startTime;
+		URLFileLength = sizeof(SPSEventLogHeader);
+		
+		internedURLs = calloc(SPS_INTERNED_URL_CAPACITY, sizeof(SPSInternedURL));
+		if (internedURLs == NULL) {
+			[self release];
+			return nil;
+		}
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[self close];
+	free(internedURLs);
+	[super dealloc];
+}
+
+- (void)recordEventOfType:(SPSEventType)type URLString:(NSString *)URLString spaceIdentifier:(NSInteger)spaceIdentifier atTime:(NSTimeInterval)time {
+	if (failed || recordFile.bytes == NULL) {
+		return;
+	}
+	
+	SPSEventLogHeader *header = (SPSEventLogHeader *)recordFile.bytes;
+	size_t length = sizeof(SPSEventLogHeader) + (header->count + 1) * sizeof(SPSEventRecord);
+	if (!SPSMappedFileReserve(&recordFile, length)) {
+		failed = YES;
+		return;
+	}
+	header = (SPSEventLogHeader *)recordFile.bytes;
+	
+	NSUInteger URLLength = [URLString lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+	
+	SPSEventRecord *record = (SPSEventRecord *)(recordFile.bytes + sizeof(SPSEventLogHeader)) + header->count;
+	record->time = (int64_t)((time - startTime) * 1000000.0);
+	record->URLIdentifier = (URLString != nil) ? [self identifierOfURLString:URLString length:URLLength] : 0;
+	record->spaceIdentifier = (int32_t)spaceIdentifier;
+	record->URLLength = (uint32_t)URLLength;
+	record->type = type;
+	record->reserved = 0;
+	
+	header->count++;
+}
+
+- (void)close {
+	if (recordFile.bytes != NULL) {
+		SPSMappedFileClose(&recordFile, sizeof(SPSEventLogHeader) + ((SPSEventLogHeader *)recordFile.bytes)->count * sizeof(SPSEventRecord));
+	}
+	SPSMappedFileClose(&URLFile, URLFileLength);
+}
+
+#pragma mark SPSEventRecorder
+
+- (uint32_t)identifierOfURLString:(NSString *)URLString length:(NSUInteger)length {
+	// Each URL is stored as its length followed by its bytes, padded to keep the lengths aligned. It is written past the end of the file first, and only kept if it has not been interned yet
+	size_t entryLength = sizeof(uint32_t) + ((length + 3) & ~(size_t)3);
+	if (!SPSMappedFileReserve(&URLFile, URLFileLength + entryLength)) {
+		return 0;
+	}
+	
+	uint8_t *entry = URLFile.bytes + URLFileLength;
+	*(uint32_t *)entry = (uint32_t)length;
+	[URLString getBytes:entry + sizeof(uint32_t) maxLength:length usedLength:NULL encoding:NSUTF8StringEncoding options:0 range:NSMakeRange(0, [URLString length]) remainingRange:NULL];
+	
+	uint64_t hash = SPSHashBytes(entry + sizeof(uint32_t), length);
+	SPSInternedURL *freeSlot = NULL;
+	for (NSUInteger probe = 0; probe < SPS_INTERNED_URL_PROBE_LIMIT; probe++) {
+		SPSInternedURL *slot = &internedURLs[(hash + probe) & (SPS_INTERNED_URL_CAPACITY - 1)];
+		if (slot->identifier == 0) {
+			freeSlot = slot;
+			break;
+		}
+		
+		// The hash only narrows it down, the bytes have to match as well
+		const uint8_t *internedEntry = URLFile.bytes + slot->offset;
+		if (slot->hash == hash && *(const uint32_t *)internedEntry == length && memcmp(internedEntry + sizeof(uint32_t), entry + sizeof(uint32_t), length) == 0) {
+			return slot->identifier;
+		}
+	}
+	if (freeSlot == NULL) {
+		freeSlot = &internedURLs[hash & (SPS_INTERNED_URL_CAPACITY - 1)];
+	}
+	
+	SPSEventLogHeader *header = (SPSEventLogHeader *)URLFile.bytes;
+	freeSlot->hash = hash;
+	freeSlot->offset = URLFileLength;
+	freeSlot->identifier = ++header->count;
+	URLFileLength += entryLength;
+	
+	return freeSlot->identifier;
+}
+
+@end
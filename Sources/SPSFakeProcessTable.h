@@ -0,0 +1,54 @@
+//
+//  SPSFakeProcessTable.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#import <Foundation/Foundation.h>
+#import "SPSProcessRegistry.h"
+
+
+/**
+ * A process backend whose processes are launched and terminated by hand, so that a process registry and what sits on top of it can be driven without real processes.
+ *
+ * Processes are reported in the order in which they were launched. Launching and terminating a process tells the delegate right away, on the calling thread.
+ */
+@interface SPSFakeProcessTable : NSObject <SPSProcessBackend> {
+	id <SPSProcessBackendDelegate> delegate;
+	NSMutableArray *processIdentifiers;
+	NSMutableDictionary *bundleIdentifiersByProcessIdentifier;
+}
+
+/**
+ * Adds a process to the table and tells the delegate about it. A process that is already in the table under the same identifier is replaced, like a process identifier that is reused.
+ *
+ * @param processIdentifier A process identifier, may not be 0.
+ * @param bundleIdentifier The bundle identifier of the process, may not be nil.
+ */
+- (void)launchProcessWithIdentifier:(pid_t)processIdentifier bundleIdentifier:(NSString *)bundleIdentifier;
+
+/**
+ * Removes a process from the table and tells the delegate about it. Does nothing if the process is not in the table.
+ */
+- (void)terminateProcessWithIdentifier:(pid_t)processIdentifier;
+
+/**
+ * Returns the number of processes in the table.
+ */
+- (NSUInteger)processCount;
+
+@end
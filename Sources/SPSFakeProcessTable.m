@@ -0,0 +1,85 @@
+//
+//  SPSFakeProcessTable.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#import "SPSFakeProcessTable.h"
+
+
+@implementation SPSFakeProcessTable
+
+- (id)init {
+	if ((self = [super init])) {
+		processIdentifiers = [[NSMutableArray alloc] init];
+		bundleIdentifiersByProcessIdentifier = [[NSMutableDictionary alloc] init];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[processIdentifiers release];
+	[bundleIdentifiersByProcessIdentifier release];
+	[super dealloc];
+}
+
+#pragma mark SPSProcessBackend
+
+- (id <SPSProcessBackendDelegate>)delegate {
+	return delegate;
+}
+
+- (void)setDelegate:(id <SPSProcessBackendDelegate>)aDelegate {
+	delegate = aDelegate;
+}
+
+- (void)enumerateProcessesUsingBlock:(void (^)(pid_t processIdentifier, NSString *bundleIdentifier))block {
+	for (NSNumber *processIdentifier in processIdentifiers) {
+		block([processIdentifier intValue], [bundleIdentifiersByProcessIdentifier objectForKey:processIdentifier]);
+	}
+}
+
+#pragma mark SPSFakeProcessTable
+
+- (void)launchProcessWithIdentifier:(pid_t)processIdentifier bundleIdentifier:(NSString *)bundleIdentifier {
+	NSNumber *key = [NSNumber numberWithInt:processIdentifier];
+	
+	// A reused process identifier belongs to the new process, which comes last
+	[processIdentifiers removeObject:key];
+	[processIdentifiers addObject:key];
+	[bundleIdentifiersByProcessIdentifier setObject:bundleIdentifier forKey:key];
+	
+	[delegate processBackend:self didLaunchProcessWithIdentifier:processIdentifier bundleIdentifier:bundleIdentifier];
+}
+
+- (void)terminateProcessWithIdentifier:(pid_t)processIdentifier {
+	NSNumber *key = [NSNumber numberWithInt:processIdentifier];
+	if ([bundleIdentifiersByProcessIdentifier objectForKey:key] == nil) {
+		return;
+	}
+	
+	[processIdentifiers removeObject:key];
+	[bundleIdentifiersByProcessIdentifier removeObjectForKey:key];
+	
+	[delegate processBackend:self didTerminateProcessWithIdentifier:processIdentifier];
+}
+
+- (NSUInteger)processCount {
+	return [processIdentifiers count];
+}
+
+@end
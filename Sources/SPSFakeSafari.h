@@ -0,0 +1,143 @@
+//
+//  SPSFakeSafari.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import "SPSSpaceWindowIndex.h"
+#import "SPSScriptingEngine.h"
+
+
+/**
+ * Stands in for Safari and System Events, so that the controller can be driven without either of them.
+ *
+ * Safari's windows are kept in memory, front to back, each with its space and number of tabs. Every command takes a fixed latency, and fails with errAETimeout if that latency does not fit before the deadline, as a real command would. A command that is given once the deadline has passed fails without being sent.
+ *
+ * Every command is counted as the Apple Event it would be sent as, named by its event class and identifier, such as "misc/actv" for activate. Handing URLs to Launch Services counts as "GURL/GURL".
+ *
+ * Safari can be quit, which drops its windows, and is launched again when it is activated. While it runs, a child process stands in for it, so that its exit can be watched like that of a real Safari.
+ *
+ * The fake can also run in virtual time, in which case commands do not wait but move the current time of the fake forward, and no process is started for Safari.
+ *
+ * Commands come in on the executor thread, while the window list is read on the main thread, so all of the state is guarded by the object itself.
+ */
+@interface SPSFakeSafari : NSObject <SPSScriptingEngine, SPSWindowListSource> {
+	id <SPSScriptingEngineDelegate> delegate;
+	NSTimeInterval latency;
+	NSTimeInterval deadline;
+	BOOL stalled;
+	NSInteger activeSpaceIdentifier;
+	NSMutableArray *windows;
+	NSInteger lastWindowIdentifier;
+	NSUInteger commandCount;
+	NSUInteger sentCommandCount;
+	NSCountedSet *sentEvents;
+	void (^windowCreationHandler)(NSInteger windowIdentifier);
+	NSTask *process;
+	void (^launchHandler)(pid_t processIdentifier);
+	BOOL usesVirtualTime;
+	NSTimeInterval virtualTime;
+	BOOL runningInVirtualTime;
+	NSTimeInterval (^latencyHandler)(SEL command);
+}
+
+/**
+ * Initializes the fake without any windows, in space 1, in real time.
+ *
+ * @param aLatency The time each command takes, in seconds.
+ */
+- (id)initWithLatency:(NSTimeInterval)aLatency;
+
+/**
+ * Initializes the fake without any windows, in space 1.
+ *
+ * @param aLatency The time each command takes, in seconds.
+ * @param virtual Whether the fake runs in virtual time, starting at 0.
+ */
+- (id)initWithLatency:(NSTimeInterval)aLatency usesVirtualTime:(BOOL)virtual;
+
+/**
+ * A block that returns the time the given command takes, in seconds, or nil for the latency the fake was made with. A command that is given INFINITY stalls until its deadline.
+ *
+ * The command is the selector of the SPSScriptingEngine method, such as @selector(activate). The block is called on the thread of the command.
+ */
+@property (copy) NSTimeInterval (^latencyHandler)(SEL command);
+
+/**
+ * Returns the current time: the virtual time if the fake runs in virtual time, or else the time of +[NSDate timeIntervalSinceReferenceDate]. Deadlines are held against this time.
+ */
+- (NSTimeInterval)currentTime;
+
+/**
+ * Sets the virtual time, for example to the time at which the executor would take on the next command. Only for a fake that runs in virtual time.
+ */
+- (void)setCurrentTime:(NSTimeInterval)time;
+
+/**
+ * The space in which new windows are made and whose windows are on screen.
+ */
+@property (assign) NSInteger activeSpaceIdentifier;
+
+/**
+ * Whether Safari has stopped answering, in which case every command waits for the deadline and fails with errAETimeout.
+ */
+@property (assign) BOOL stalled;
+
+/**
+ * The number of commands that have been sent so far, including ones that failed after being sent, and URLs handed to Launch Services.
+ */
+@property (readonly) NSUInteger commandCount;
+
+/**
+ * Returns the names of the Apple Events that have been sent since the fake was made or last reset, each counted as often as it was sent.
+ */
+- (NSCountedSet *)sentEvents;
+
+/**
+ * Forgets the Apple Events that have been sent so far, so that the next ones can be counted on their own.
+ */
+- (void)resetSentEvents;
+
+/**
+ * A block that is called on the executor thread when a window has been made, or nil. Stands in for the accessibility notification Safari would post.
+ */
+@property (copy) void (^windowCreationHandler)(NSInteger windowIdentifier);
+
+/**
+ * A block that is called on the executor thread when activating Safari has launched it, or nil. Stands in for the notification the workspace would post.
+ */
+@property (copy) void (^launchHandler)(pid_t processIdentifier);
+
+/**
+ * Launches Safari without activating it, if it is not running. In virtual time, the current process stands in for Safari.
+ */
+- (void)launch;
+
+/**
+ * Quits Safari, which closes its windows and ends the process that stands in for it. Does nothing if Safari is not running.
+ */
+- (void)quit;
+
+/**
+ * Returns the identifier of the process that stands in for Safari, or 0 if Safari is not running.
+ */
+- (pid_t)processIdentifier;
+
+@end
+
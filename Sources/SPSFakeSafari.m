@@ -0,0 +1,425 @@
+//
+//  SPSFakeSafari.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSFakeSafari.h"
+#import "SPSSafariDriver.h"
+#include <math.h>
+
+
+#define SPS_FAKE_WINDOW_IDENTIFIER_KEY @"identifier"
+#define SPS_FAKE_WINDOW_SPACE_KEY @"space"
+#define SPS_FAKE_WINDOW_TAB_COUNT_KEY @"tabCount"
+#define SPS_FAKE_WINDOW_MINIATURIZED_KEY @"miniaturized"
+
+
+/**
+ * Returns the name of an Apple Event, such as "misc/actv".
+ */
+static NSString *SPSAppleEventName(AEEventClass eventClass, AEEventID eventID) {
+	return [NSString stringWithFormat:@"%c%c%c%c/%c%c%c%c", (char)(eventClass >> 24), (char)(eventClass >> 16), (char)(eventClass >> 8), (char)eventClass, (char)(eventID >> 24), (char)(eventID >> 16), (char)(eventID >> 8), (char)eventID];
+}
+
+
+@interface SPSFakeSafari ()
+
+/**
+ * Counts and takes the time of a command.
+ *
+ * @param command The selector of the command, which its latency is looked up by.
+ * @param eventClass The event class of the Apple Event the command would be sent as.
+ * @param eventID The event identifier of the Apple Event the command would be sent as.
+ * @return YES if the command is answered, or NO if it timed out, in which case the delegate has been told.
+ */
+- (BOOL)performCommand:(SEL)command eventClass:(AEEventClass)eventClass eventID:(AEEventID)eventID;
+
+/**
+ * Returns the time the given command takes.
+ */
+- (NSTimeInterval)latencyOfCommand:(SEL)command;
+
+/**
+ * Lets the given time pass, by waiting or, in virtual time, by moving the current time forward.
+ */
+- (void)passTime:(NSTimeInterval)duration;
+
+/**
+ * Returns the given window, or nil if Safari has no such window. Must be called while synchronized.
+ */
+- (NSMutableDictionary *)windowWithIdentifier:(NSInteger)windowIdentifier;
+
+/**
+ * Returns whether the given window is on screen in the active space. Must be called while synchronized.
+ */
+- (BOOL)isWindowOnScreen:(NSDictionary *)window;
+
+@end
+
+
+@implementation SPSFakeSafari
+
+@synthesize activeSpaceIdentifier;
+@synthesize stalled;
+@synthesize commandCount;
+@synthesize windowCreationHandler;
+@synthesize launchHandler;
+@synthesize latencyHandler;
+
+- (id)initWithLatency:(NSTimeInterval)aLatency {
+	return [self initWithLatency:aLatency usesVirtualTime:NO];
+}
+
+- (id)initWithLatency:(NSTimeInterval)aLatency usesVirtualTime:(BOOL)virtual {
+	if ((self = [super init])) {
+		latency = aLatency;
+		usesVirtualTime = virtual;
+		activeSpaceIdentifier = 1;
+		windows = [[NSMutableArray alloc] init];
+		sentEvents = [[NSCountedSet alloc] init];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[windows release];
+	[sentEvents release];
+	[windowCreationHandler release];
+	[launchHandler release];
+	[latencyHandler release];
+	if ([process isRunning]) {
+		[process terminate];
+	}
+	[process release];
+	[super dealloc];
+}
+
+#pragma mark SPSScriptingEngine
+
+- (void)setDelegate:(id <SPSScriptingEngineDelegate>)aDelegate {
+	delegate = aDelegate;
+}
+
+- (void)setDeadline:(NSTimeInterval)aDeadline {
+	deadline = aDeadline;
+}
+
+- (void)activate {
+	if (![self performCommand:_cmd eventClass:kAEMiscStandards eventID:kAEActivate]) {
+		return;
+	}
+	
+	// Activating a Safari that is not running launches it
+	if ([self processIdentifier] == 0) {
+		[self launch];
+		
+		void (^handler)(pid_t) = [self launchHandler];
+		if (handler != nil) {
+			handler([self processIdentifier]);
+		}
+	}
+}
+
+- (void)raiseWindow:(NSInteger)windowIdentifier {
+	if ([self performCommand:_cmd eventClass:kAECoreSuite eventID:kAESetData]) {
+		@synchronized (self) {
+			NSMutableDictionary *window = [self windowWithIdentifier:windowIdentifier];
+			
+			if (window != nil) {
+				[window retain];
+				[windows removeObject:window];
+				[windows insertObject:window atIndex:0];
+				[window release];
+			}
+		}
+	}
+}
+
+- (void)setMiniaturized:(BOOL)miniaturized ofWindow:(NSInteger)windowIdentifier {
+	if ([self performCommand:_cmd eventClass:kAECoreSuite eventID:kAESetData]) {
+		@synchronized (self) {
+			[[self windowWithIdentifier:windowIdentifier] setObject:[NSNumber numberWithBool:miniaturized] forKey:SPS_FAKE_WINDOW_MINIATURIZED_KEY];
+		}
+	}
+}
+
+- (void)closeWindow:(NSInteger)windowIdentifier {
+	if ([self performCommand:_cmd eventClass:kAECoreSuite eventID:kAEClose]) {
+		@synchronized (self) {
+			NSMutableDictionary *window = [self windowWithIdentifier:windowIdentifier];
+			
+			if (window != nil) {
+				[windows removeObject:window];
+			}
+		}
+	}
+}
+
+- (NSInteger)frontWindowIdentifier {
+	if (![self performCommand:_cmd eventClass:kAECoreSuite eventID:kAEGetData]) {
+		return 0;
+	}
+	
+	@synchronized (self) {
+		return ([windows count] > 0) ? [[[windows objectAtIndex:0] objectForKey:SPS_FAKE_WINDOW_IDENTIFIER_KEY] integerValue] : 0;
+	}
+}
+
+- (NSUInteger)countOfTabsInWindow:(NSInteger)windowIdentifier {
+	if (![self performCommand:_cmd eventClass:kAECoreSuite eventID:kAECountElements]) {
+		return 0;
+	}
+	
+	@synchronized (self) {
+		return [[[self windowWithIdentifier:windowIdentifier] objectForKey:SPS_FAKE_WINDOW_TAB_COUNT_KEY] unsignedIntegerValue];
+	}
+}
+
+- (void)makeDocumentWithURL:(NSURL *)URL {
+	if (![self performCommand:_cmd eventClass:kAECoreSuite eventID:kAECreateElement]) {
+		return;
+	}
+	
+	NSInteger windowIdentifier;
+	@synchronized (self) {
+		windowIdentifier = ++lastWindowIdentifier;
+		
+		NSMutableDictionary *window = [NSMutableDictionary dictionaryWithCapacity:4];
+		[window setObject:[NSNumber numberWithInteger:windowIdentifier] forKey:SPS_FAKE_WINDOW_IDENTIFIER_KEY];
+		[window setObject:[NSNumber numberWithInteger:activeSpaceIdentifier] forKey:SPS_FAKE_WINDOW_SPACE_KEY];
+		[window setObject:[NSNumber numberWithUnsignedInteger:1] forKey:SPS_FAKE_WINDOW_TAB_COUNT_KEY];
+		[window setObject:[NSNumber numberWithBool:NO] forKey:SPS_FAKE_WINDOW_MINIATURIZED_KEY];
+		[windows insertObject:window atIndex:0];
+	}
+	
+	void (^handler)(NSInteger) = [self windowCreationHandler];
+	if (handler != nil) {
+		handler(windowIdentifier);
+	}
+}
+
+- (void)setURL:(NSURL *)URL ofTab:(NSUInteger)tabIndex inWindow:(NSInteger)windowIdentifier {
+	[self performCommand:_cmd eventClass:kAECoreSuite eventID:kAESetData];
+}
+
+- (BOOL)openURLs:(NSArray *)URLs {
+	// Launch Services does not time out, so a stalled Safari still takes the URLs
+	@synchronized (self) {
+		commandCount++;
+		[sentEvents addObject:SPSAppleEventName(kInternetEventClass, kAEGetURL)];
+	}
+	[self passTime:[self latencyOfCommand:_cmd]];
+	
+	@synchronized (self) {
+		if ([windows count] == 0) {
+			return NO;
+		}
+		
+		NSMutableDictionary *window = [windows objectAtIndex:0];
+		NSUInteger tabCount = [[window objectForKey:SPS_FAKE_WINDOW_TAB_COUNT_KEY] unsignedIntegerValue] + [URLs count];
+		[window setObject:[NSNumber numberWithUnsignedInteger:tabCount] forKey:SPS_FAKE_WINDOW_TAB_COUNT_KEY];
+	}
+	
+	return YES;
+}
+
+- (NSUInteger)countOfWindowsOfProcessWithIdentifier:(pid_t)processIdentifier {
+	if (![self performCommand:_cmd eventClass:kAECoreSuite eventID:kAECountElements]) {
+		return 0;
+	}
+	
+	NSUInteger windowCount = 0;
+	@synchronized (self) {
+		for (NSDictionary *window in windows) {
+			if ([self isWindowOnScreen:window]) {
+				windowCount++;
+			}
+		}
+	}
+	return windowCount;
+}
+
+- (NSUInteger)sentCommandCount {
+	@synchronized (self) {
+		return sentCommandCount;
+	}
+}
+
+- (void)reset {
+	// There is no connection to drop
+}
+
+#pragma mark SPSWindowListSource
+
+- (NSArray *)onScreenWindowIdentifiersOfProcessWithIdentifier:(pid_t)processIdentifier {
+	NSMutableArray *windowIdentifiers = [NSMutableArray array];
+	
+	@synchronized (self) {
+		for (NSDictionary *window in windows) {
+			if ([self isWindowOnScreen:window]) {
+				[windowIdentifiers addObject:[window objectForKey:SPS_FAKE_WINDOW_IDENTIFIER_KEY]];
+			}
+		}
+	}
+	
+	return windowIdentifiers;
+}
+
+#pragma mark SPSFakeSafari
+
+- (void)launch {
+	@synchronized (self) {
+		if (usesVirtualTime) {
+			runningInVirtualTime = YES;
+			return;
+		}
+		if ([process isRunning]) {
+			return;
+		}
+		[process release];
+		
+		// The stand-in waits for input that never comes, and so exits with us at the latest
+		process = [[NSTask alloc] init];
+		[process setLaunchPath:@"/bin/cat"];
+		[process setStandardInput:[NSPipe pipe]];
+		[process setStandardOutput:[NSFileHandle fileHandleWithNullDevice]];
+		
+		[process launch];
+	}
+}
+
+- (void)quit {
+	@synchronized (self) {
+		[windows removeAllObjects];
+		runningInVirtualTime = NO;
+		if ([process isRunning]) {
+			[process terminate];
+		}
+		[process release];
+		process = nil;
+	}
+}
+
+- (pid_t)processIdentifier {
+	@synchronized (self) {
+		if (usesVirtualTime) {
+			return runningInVirtualTime ? getpid() : 0;
+		}
+		return [process isRunning] ? [process processIdentifier] : 0;
+	}
+}
+
+- (NSTimeInterval)currentTime {
+	if (!usesVirtualTime) {
+		return [NSDate timeIntervalSinceReferenceDate];
+	}
+	
+	@synchronized (self) {
+		return virtualTime;
+	}
+}
+
+- (void)setCurrentTime:(NSTimeInterval)time {
+	@synchronized (self) {
+		virtualTime = time;
+	}
+}
+
+- (NSCountedSet *)sentEvents {
+	@synchronized (self) {
+		return [[[NSCountedSet alloc] initWithSet:sentEvents] autorelease];
+	}
+}
+
+- (void)resetSentEvents {
+	@synchronized (self) {
+		[sentEvents removeAllObjects];
+	}
+}
+
+- (BOOL)performCommand:(SEL)command eventClass:(AEEventClass)eventClass eventID:(AEEventID)eventID {
+	NSTimeInterval now = [self currentTime];
+	NSTimeInterval duration = [self latencyOfCommand:command];
+	BOOL timesOut = NO;
+	
+	@synchronized (self) {
+		// Like a real engine, a command that cannot be answered in time is not even sent
+		if (deadline > 0.0 && now >= deadline) {
+			duration = 0.0;
+			timesOut = YES;
+		}
+		else {
+			commandCount++;
+			sentCommandCount++;
+			[sentEvents addObject:SPSAppleEventName(eventClass, eventID)];
+			
+			// A command that would be answered after the deadline gives up at the deadline
+			BOOL stalls = stalled || isinf(duration);
+			if (stalls || (deadline > 0.0 && now + duration > deadline)) {
+				duration = (deadline > 0.0) ? deadline - now : (isinf(duration) ? latency : duration);
+				timesOut = YES;
+			}
+		}
+	}
+	
+	[self passTime:duration];
+	
+	if (timesOut) {
+		[delegate scriptingEngine:self didFailWithError:[NSError errorWithDomain:NSOSStatusErrorDomain code:errAETimeout userInfo:nil]];
+	}
+	
+	return !timesOut;
+}
+
+- (NSTimeInterval)latencyOfCommand:(SEL)command {
+	NSTimeInterval (^handler)(SEL) = [self latencyHandler];
+	return (handler != nil) ? handler(command) : latency;
+}
+
+- (void)passTime:(NSTimeInterval)duration {
+	if (duration <= 0.0) {
+		return;
+	}
+	
+	if (usesVirtualTime) {
+		@synchronized (self) {
+			virtualTime += duration;
+		}
+	}
+	else {
+		[NSThread sleepForTimeInterval:duration];
+	}
+}
+
+- (NSMutableDictionary *)windowWithIdentifier:(NSInteger)windowIdentifier {
+	for (NSMutableDictionary *window in windows) {
+		if ([[window objectForKey:SPS_FAKE_WINDOW_IDENTIFIER_KEY] integerValue] == windowIdentifier) {
+			return window;
+		}
+	}
+	
+	return nil;
+}
+
+- (BOOL)isWindowOnScreen:(NSDictionary *)window {
+	return [[window objectForKey:SPS_FAKE_WINDOW_SPACE_KEY] integerValue] == activeSpaceIdentifier && ![[window objectForKey:SPS_FAKE_WINDOW_MINIATURIZED_KEY] boolValue];
+}
+
+@end
+
@@ -0,0 +1,150 @@
+//
+//  SPSMetrics.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ * Counters that are updated on the event path.
+ */
+typedef enum {
+	SPSCounterURLBatches,
+	SPSCounterBatchedURLs,
+	SPSCounterLargestURLBatch,
+	SPSCounterCoalescingMicroseconds,
+	SPSCounterActivations,
+	SPSCounterJoinedActivations,
+	SPSCounterSafariLaunches,
+	SPSCounterSafariExits,
+	SPSCounterWindowCreations,
+	SPSCounterJoinedWindowCreations,
+	SPSCounterNewWindowPathLinks,
+	SPSCounterNewWindowPathAppleEvents,
+	SPSCounterNewWindowPathMicroseconds,
+	SPSCounterNewTabPathLinks,
+	SPSCounterNewTabPathAppleEvents,
+	SPSCounterNewTabPathMicroseconds,
+	SPSCounterWindowIndexHits,
+	SPSCounterWindowIndexResyncs,
+	SPSCounterConnectionCacheHits,
+	SPSCounterConnectionConstructions,
+	SPSCounterConnectionConstructionMicroseconds,
+	SPSCounterScriptingBridgeCommands,
+	SPSCounterScriptingBridgeMicroseconds,
+	SPSCounterAppleEventCommands,
+	SPSCounterAppleEventMicroseconds,
+	SPSCounterCancelledRequests,
+	SPSCounterActivateDeadlineMisses,
+	SPSCounterRaiseWindowDeadlineMisses,
+	SPSCounterFrontWindowDeadlineMisses,
+	SPSCounterCountTabsDeadlineMisses,
+	SPSCounterMakeDocumentDeadlineMisses,
+	SPSCounterSetURLDeadlineMisses,
+	SPSCounterCountWindowsDeadlineMisses,
+	SPSCounterOpenURLsDeadlineMisses,
+	SPSCounterCircuitBreakerOpens,
+	SPSCounterCircuitBreakerProbes,
+	SPSCounterCircuitBreakerCloses,
+	SPSCounterDegradedBatches,
+	SPSCounterStartupMicroseconds,
+	SPSCounterStartupBudgetMisses,
+	SPSCounterSafariWarmUps,
+	SPSCounterWarmFirstLinkMicroseconds,
+	SPSCounterColdFirstLinkMicroseconds,
+	SPSCounterMiniaturizeDeadlineMisses,
+	SPSCounterCloseWindowDeadlineMisses,
+	SPSCounterWindowPoolCreations,
+	SPSCounterWindowPoolHits,
+	SPSCounterWindowPoolMisses,
+	SPSCounterWindowPoolEvictions,
+	SPSCounterWindowPoolWindows,
+	SPSCounterWindowPoolBytes,
+	SPSCounterSocketConnections,
+	SPSCounterSocketURLs,
+	SPSCounterExecutorRejections,
+	SPSCounterMergedRequests,
+	SPSCounterCount
+} SPSCounter;
+
+/**
+ * Histograms of durations on the event path, in microseconds.
+ */
+typedef enum {
+	SPSHistogramLinkMicroseconds,
+	SPSHistogramCoalescingMicroseconds,
+	SPSHistogramDispatchMicroseconds,
+	SPSHistogramActivationMicroseconds,
+	SPSHistogramAppleEventMicroseconds,
+	SPSHistogramCount
+} SPSHistogram;
+
+
+/**
+ * Adds the given amount to a counter. Safe to call from any thread.
+ */
+void SPSCounterAdd(SPSCounter counter, int64_t amount);
+
+/**
+ * Raises a counter to the given value, if it is currently lower. Safe to call from any thread.
+ */
+void SPSCounterRaise(SPSCounter counter, int64_t value);
+
+/**
+ * Returns the current value of a counter.
+ */
+int64_t SPSCounterGetValue(SPSCounter counter);
+
+/**
+ * Returns the name under which a counter is reported.
+ */
+NSString *SPSCounterGetName(SPSCounter counter);
+
+/**
+ * Returns a dictionary of all counter names and their current values.
+ */
+NSDictionary *SPSCounterSnapshot(void);
+
+/**
+ * Records a value in a histogram. Safe to call from any thread, and neither allocates nor locks.
+ *
+ * Values are kept in buckets with 3 significant bits, so that a value is known to within 12.5% whatever its magnitude. Negative values are recorded as 0.
+ */
+void SPSHistogramRecord(SPSHistogram histogram, int64_t value);
+
+/**
+ * Returns the number of values recorded in a histogram.
+ */
+int64_t SPSHistogramGetCount(SPSHistogram histogram);
+
+/**
+ * Returns the value below which the given fraction of the values recorded in a histogram lie, rounded up to the end of its bucket, or 0 if nothing has been recorded.
+ */
+int64_t SPSHistogramGetPercentile(SPSHistogram histogram, double fraction);
+
+/**
+ * Returns the name under which a histogram is reported.
+ */
+NSString *SPSHistogramGetName(SPSHistogram histogram);
+
+/**
+ * Returns all counters and histograms in the Prometheus text exposition format, so that they can be scraped by existing monitoring.
+ */
+NSString *SPSMetricsTextSnapshot(void);
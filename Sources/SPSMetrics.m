@@ -0,0 +1,266 @@
+//
+//  SPSMetrics.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSMetrics.h"
+#import <libkern/OSAtomic.h>
+#include <math.h>
+
+
+/**
+ * The number of buckets in a power of two, and the number of buckets it takes to cover every positive int64_t.
+ */
+#define SPS_HISTOGRAM_SUB_BUCKET_BITS 3
+#define SPS_HISTOGRAM_SUB_BUCKET_COUNT (1 << SPS_HISTOGRAM_SUB_BUCKET_BITS)
+#define SPS_HISTOGRAM_BUCKET_COUNT ((64 - SPS_HISTOGRAM_SUB_BUCKET_BITS) * SPS_HISTOGRAM_SUB_BUCKET_COUNT)
+
+/**
+ * The largest power of two, in microseconds, up to which histogram buckets are reported: about 67 seconds.
+ */
+#define SPS_HISTOGRAM_REPORTED_EXPONENT 26
+
+
+static volatile int64_t SPSCounterValues[SPSCounterCount];
+static volatile int64_t SPSHistogramBuckets[SPSHistogramCount][SPS_HISTOGRAM_BUCKET_COUNT];
+static volatile int64_t SPSHistogramSums[SPSHistogramCount];
+
+static NSString * const SPSCounterNames[SPSCounterCount] = {
+	@"url_batches",
+	@"batched_urls",
+	@"largest_url_batch",
+	@"coalescing_microseconds",
+	@"activations",
+	@"joined_activations",
+	@"safari_launches",
+	@"safari_exits",
+	@"window_creations",
+	@"joined_window_creations",
+	@"new_window_path_links",
+	@"new_window_path_apple_events",
+	@"new_window_path_microseconds",
+	@"new_tab_path_links",
+	@"new_tab_path_apple_events",
+	@"new_tab_path_microseconds",
+	@"window_index_hits",
+	@"window_index_resyncs",
+	@"connection_cache_hits",
+	@"connection_constructions",
+	@"connection_construction_microseconds",
+	@"scripting_bridge_commands",
+	@"scripting_bridge_microseconds",
+	@"apple_event_commands",
+	@"apple_event_microseconds",
+	@"cancelled_requests",
+	@"activate_deadline_misses",
+	@"raise_window_deadline_misses",
+	@"front_window_deadline_misses",
+	@"count_tabs_deadline_misses",
+	@"make_document_deadline_misses",
+	@"set_url_deadline_misses",
+	@"count_windows_deadline_misses",
+	@"open_urls_deadline_misses",
+	@"circuit_breaker_opens",
+	@"circuit_breaker_probes",
+	@"circuit_breaker_closes",
+	@"degraded_batches",
+	@"startup_microseconds",
+	@"startup_budget_misses",
+	@"safari_warm_ups",
+	@"warm_first_link_microseconds",
+	@"cold_first_link_microseconds",
+	@"miniaturize_deadline_misses",
+	@"close_window_deadline_misses",
+	@"window_pool_creations",
+	@"window_pool_hits",
+	@"window_pool_misses",
+	@"window_pool_evictions",
+	@"window_pool_windows",
+	@"window_pool_bytes",
+	@"socket_connections",
+	@"socket_urls",
+	@"executor_rejections",
+	@"merged_requests",
+};
+
+static NSString * const SPSHistogramNames[SPSHistogramCount] = {
+	@"link_microseconds",
+	@"coalescing_delay_microseconds",
+	@"dispatch_microseconds",
+	@"activation_microseconds",
+	@"apple_event_latency_microseconds",
+};
+
+
+/**
+ * Returns the bucket of a value. Values below SPS_HISTOGRAM_SUB_BUCKET_COUNT have a bucket each; above that, every power of two is split into SPS_HISTOGRAM_SUB_BUCKET_COUNT buckets.
+ */
+static inline int SPSHistogramBucketOfValue(int64_t value) {
+	if (value < SPS_HISTOGRAM_SUB_BUCKET_COUNT) {
+		return (value > 0) ? (int)value : 0;
+	}
+	
+	int exponent = 63 - __builtin_clzll((uint64_t)value);
+	int shift = exponent - SPS_HISTOGRAM_SUB_BUCKET_BITS;
+	return (shift + 1) * SPS_HISTOGRAM_SUB_BUCKET_COUNT + (int)((value >> shift) - SPS_HISTOGRAM_SUB_BUCKET_COUNT);
+}
+
+/**
+ * Returns the largest value that falls in a bucket.
+ */
+static int64_t SPSHistogramBucketUpperBound(int bucket) {
+	if (bucket < SPS_HISTOGRAM_SUB_BUCKET_COUNT) {
+		return bucket;
+	}
+	
+	int shift = bucket / SPS_HISTOGRAM_SUB_BUCKET_COUNT - 1;
+	int64_t lowerBound = (int64_t)(SPS_HISTOGRAM_SUB_BUCKET_COUNT + bucket % SPS_HISTOGRAM_SUB_BUCKET_COUNT) << shift;
+	return lowerBound + ((int64_t)1 << shift) - 1;
+}
+
+
+/**
+ * Returns whether a counter holds a level that can also go down, or a high-water mark, rather than a running total.
+ */
+static BOOL SPSCounterIsGauge(SPSCounter counter) {
+	switch (counter) {
+		case SPSCounterLargestURLBatch:
+		case SPSCounterStartupMicroseconds:
+		case SPSCounterWarmFirstLinkMicroseconds:
+		case SPSCounterColdFirstLinkMicroseconds:
+		case SPSCounterWindowPoolWindows:
+		case SPSCounterWindowPoolBytes:
+			return YES;
+		default:
+			return NO;
+	}
+}
+
+
+void SPSCounterAdd(SPSCounter counter, int64_t amount) {
+	// Counters are independent of each other and of other memory, so the adds need no barrier
+	OSAtomicAdd64(amount, &SPSCounterValues[counter]);
+}
+
+void SPSCounterRaise(SPSCounter counter, int64_t value) {
+	int64_t currentValue;
+	do {
+		currentValue = SPSCounterValues[counter];
+		if (currentValue >= value) {
+			return;
+		}
+	} while (!OSAtomicCompareAndSwap64(currentValue, value, &SPSCounterValues[counter]));
+}
+
+int64_t SPSCounterGetValue(SPSCounter counter) {
+	return OSAtomicAdd64Barrier(0, &SPSCounterValues[counter]);
+}
+
+NSString *SPSCounterGetName(SPSCounter counter) {
+	return SPSCounterNames[counter];
+}
+
+void SPSHistogramRecord(SPSHistogram histogram, int64_t value) {
+	OSAtomicAdd64(1, &SPSHistogramBuckets[histogram][SPSHistogramBucketOfValue(value)]);
+	OSAtomicAdd64(MAX(value, 0), &SPSHistogramSums[histogram]);
+}
+
+int64_t SPSHistogramGetCount(SPSHistogram histogram) {
+	int64_t count = 0;
+	
+	for (int bucket = 0; bucket < SPS_HISTOGRAM_BUCKET_COUNT; bucket++) {
+		count += SPSHistogramBuckets[histogram][bucket];
+	}
+	
+	return count;
+}
+
+int64_t SPSHistogramGetPercentile(SPSHistogram histogram, double fraction) {
+	int64_t count = SPSHistogramGetCount(histogram);
+	if (count == 0) {
+		return 0;
+	}
+	
+	// Nearest rank, so that the largest value is found for a fraction of 1
+	int64_t rank = MAX((int64_t)ceil(fraction * count), 1);
+	int64_t seen = 0;
+	for (int bucket = 0; bucket < SPS_HISTOGRAM_BUCKET_COUNT; bucket++) {
+		seen += SPSHistogramBuckets[histogram][bucket];
+		if (seen >= rank) {
+			return SPSHistogramBucketUpperBound(bucket);
+		}
+	}
+	
+	// Values recorded while counting can leave the rank just out of reach
+	return SPSHistogramBucketUpperBound(SPS_HISTOGRAM_BUCKET_COUNT - 1);
+}
+
+NSString *SPSHistogramGetName(SPSHistogram histogram) {
+	return SPSHistogramNames[histogram];
+}
+
+NSDictionary *SPSCounterSnapshot(void) {
+	NSMutableDictionary *snapshot = [NSMutableDictionary dictionaryWithCapacity:SPSCounterCount];
+	
+	for (int counter = 0; counter < SPSCounterCount; counter++) {
+		[snapshot setObject:[NSNumber numberWithLongLong:SPSCounterGetValue(counter)] forKey:SPSCounterGetName(counter)];
+	}
+	
+	return snapshot;
+}
+
+NSString *SPSMetricsTextSnapshot(void) {
+	NSMutableString *snapshot = [NSMutableString string];
+	
+	for (int counter = 0; counter < SPSCounterCount; counter++) {
+		NSString *name = SPSCounterGetName(counter);
+		[snapshot appendFormat:@"# TYPE sps_%@ %s\n", name, SPSCounterIsGauge(counter) ? "gauge" : "counter"];
+		[snapshot appendFormat:@"sps_%@ %lld\n", name, SPSCounterGetValue(counter)];
+	}
+	
+	for (int histogram = 0; histogram < SPSHistogramCount; histogram++) {
+		NSString *name = SPSHistogramGetName(histogram);
+		[snapshot appendFormat:@"# TYPE sps_%@ histogram\n", name];
+		
+		// The buckets split exactly at powers of two, so those are the boundaries reported
+		int64_t cumulativeCount = 0;
+		int bucket = 0;
+		for (int exponent = 0; exponent <= SPS_HISTOGRAM_REPORTED_EXPONENT; exponent++) {
+			int64_t upperBound = ((int64_t)1 << exponent) - 1;
+			for (; bucket < SPS_HISTOGRAM_BUCKET_COUNT && SPSHistogramBucketUpperBound(bucket) <= upperBound; bucket++) {
+				cumulativeCount += SPSHistogramBuckets[histogram][bucket];
+			}
+			[snapshot appendFormat:@"sps_%@_bucket{le=\"%lld\"} %lld\n", name, upperBound, cumulativeCount];
+		}
+		for (; bucket < SPS_HISTOGRAM_BUCKET_COUNT; bucket++) {
+			cumulativeCount += SPSHistogramBuckets[histogram][bucket];
+		}
+		[snapshot appendFormat:@"sps_%@_bucket{le=\"+Inf\"} %lld\n", name, cumulativeCount];
+		[snapshot appendFormat:@"sps_%@_sum %lld\n", name, SPSHistogramSums[histogram]];
+		[snapshot appendFormat:@"sps_%@_count %lld\n", name, cumulativeCount];
+		
+		// Percentiles at the resolution of the buckets, for monitoring that does not compute its own. They are not samples of a histogram, so they are a family of their own
+		[snapshot appendFormat:@"# TYPE sps_%@_percentile gauge\n", name];
+		[snapshot appendFormat:@"sps_%@_percentile{quantile=\"0.5\"} %lld\n", name, SPSHistogramGetPercentile(histogram, 0.5)];
+		[snapshot appendFormat:@"sps_%@_percentile{quantile=\"0.99\"} %lld\n", name, SPSHistogramGetPercentile(histogram, 0.99)];
+		[snapshot appendFormat:@"sps_%@_percentile{quantile=\"1\"} %lld\n", name, SPSHistogramGetPercentile(histogram, 1.0)];
+	}
+	
+	return snapshot;
+}
@@ -0,0 +1,60 @@
+//
+//  SPSMetricsServer.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ * The user defaults key of the path of the metrics socket. Defaults to metrics.sock in the application's caches folder; an empty path turns the socket off.
+ */
+#define SPS_METRICS_SOCKET_DEFAULT @"MetricsSocket"
+
+
+/**
+ * Serves SPSMetricsTextSnapshot() on a Unix-domain socket, so that monitoring can scrape it with, for example, nc -U.
+ *
+ * Every connection is sent a snapshot and closed right away. Connections are handled on a background queue, away from the event path, and a client that does not read is given up on after a second.
+ */
+@interface SPSMetricsServer : NSObject {
+	NSString *path;
+	int socketDescriptor;
+	dispatch_source_t source;
+}
+
+/**
+ * Initializes the server and starts listening, replacing any socket left at the given path. The socket is only accessible to the current user.
+ *
+ * @param aPath The path of the socket, may not be nil.
+ * @return The server, or nil if the socket could not be set up.
+ */
+- (id)initWithPath:(NSString *)aPath;
+
+/**
+ * Stops listening and removes the socket. Must be called before the server is released.
+ */
+- (void)invalidate;
+
+/**
+ * Returns the default path of the socket.
+ */
++ (NSString *)defaultPath;
+
+@end
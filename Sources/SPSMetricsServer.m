@@ -0,0 +1,140 @@
+//
+//  SPSMetricsServer.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSMetricsServer.h"
+#import "SPSMetrics.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+@interface SPSMetricsServer ()
+
+/**
+ * Accepts a pending connection and sends it a snapshot.
+ */
+- (void)acceptConnection;
+
+@end
+
+
+@implementation SPSMetricsServer
+
++ (NSString *)defaultPath {
+	NSString *cachesPath = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) lastObject];
+	return [[cachesPath stringByAppendingPathComponent:[[NSBundle mainBundle] bundleIdentifier]] stringByAppendingPathComponent:@"metrics.sock"];
+}
+
+- (id)initWithPath:(NSString *)aPath {
+	if ((self = [super init])) {
+		path = [aPath copy];
+		
+		struct sockaddr_un address;
+		memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		if (![path getFileSystemRepresentation:address.sun_path maxLength:sizeof(address.sun_path)]) {
+			socketDescriptor = -1;
+			[self release];
+			return nil;
+		}
+		
+		[[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:NULL];
+		unlink(address.sun_path);
+		
+		// Only the user can connect, since the counters tell what they are browsing and when
+		socketDescriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (socketDescriptor == -1 || bind(socketDescriptor, (struct sockaddr *)&address, sizeof(address)) != 0 || chmod(address.sun_path, S_IRUSR | S_IWUSR) != 0 || listen(socketDescriptor, 8) != 0) {
+			[self release];
+			return nil;
+		}
+		
+		source = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, socketDescriptor, 0, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0));
+		
+		// A handler may still be running on the queue when the owner lets go, so the server stays around until the source is cancelled
+		__block SPSMetricsServer *server = [self retain];
+		dispatch_source_set_event_handler(source, ^{
+			[server acceptConnection];
+		});
+		
+		int listeningDescriptor = socketDescriptor;
+		dispatch_source_set_cancel_handler(source, ^{
+			close(listeningDescriptor);
+			[server release];
+		});
+		dispatch_resume(source);
+	}
+	return self;
+}
+
+- (void)dealloc {
+	// Once the source is set up, its cancel handler closes the socket
+	if (source == NULL && socketDescriptor != -1) {
+		close(socketDescriptor);
+	}
+	[path release];
+	[super dealloc];
+}
+
+- (void)invalidate {
+	if (source != NULL) {
+		dispatch_source_cancel(source);
+		dispatch_release(source);
+		source = NULL;
+		socketDescriptor = -1;
+		
+		unlink([path fileSystemRepresentation]);
+	}
+}
+
+#pragma mark SPSMetricsServer
+
+- (void)acceptConnection {
+	int connection = accept(socketDescriptor, NULL, NULL);
+	if (connection == -1) {
+		return;
+	}
+	
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+	
+	// Do not let a client that stopped reading hold up the queue, or kill us when it goes away
+	struct timeval timeout = {1, 0};
+	int noSignal = 1;
+	setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	setsockopt(connection, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+	
+	NSData *snapshot = [SPSMetricsTextSnapshot() dataUsingEncoding:NSUTF8StringEncoding];
+	const uint8_t *bytes = [snapshot bytes];
+	NSUInteger remaining = [snapshot length];
+	while (remaining > 0) {
+		ssize_t written = write(connection, bytes, remaining);
+		if (written <= 0) {
+			break;
+		}
+		bytes += written;
+		remaining -= written;
+	}
+	
+	close(connection);
+	[pool release];
+}
+
+@end
@@ -0,0 +1,121 @@
+//
+//  SPSOpenProtocol.c
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "SPSOpenProtocol.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Returns a 32-bit big-endian number.
+ */
+static uint32_t SPSOpenReadUInt32(const uint8_t *bytes) {
+	return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | (uint32_t)bytes[3];
+}
+
+/**
+ * Writes a 32-bit big-endian number.
+ */
+static void SPSOpenWriteUInt32(uint32_t value, uint8_t *bytes) {
+	bytes[0] = (uint8_t)(value >> 24);
+	bytes[1] = (uint8_t)(value >> 16);
+	bytes[2] = (uint8_t)(value >> 8);
+	bytes[3] = (uint8_t)value;
+}
+
+void SPSOpenDecoderInit(SPSOpenDecoder *decoder) {
+	decoder->buffer = NULL;
+	decoder->start = 0;
+	decoder->end = 0;
+	decoder->capacity = 0;
+}
+
+void SPSOpenDecoderDestroy(SPSOpenDecoder *decoder) {
+	free(decoder->buffer);
+	SPSOpenDecoderInit(decoder);
+}
+
+int SPSOpenDecoderAppend(SPSOpenDecoder *decoder, const void *bytes, size_t count) {
+	// Move what is left of the last read to the front before deciding whether to grow
+	if (decoder->start > 0) {
+		memmove(decoder->buffer, decoder->buffer + decoder->start, decoder->end - decoder->start);
+		decoder->end -= decoder->start;
+		decoder->start = 0;
+	}
+	
+	if (decoder->end + count > decoder->capacity) {
+		size_t capacity = (decoder->capacity > 0) ? decoder->capacity : 4096;
+		while (capacity < decoder->end + count) {
+			capacity *= 2;
+		}
+		
+		uint8_t *buffer = realloc(decoder->buffer, capacity);
+		if (buffer == NULL) {
+			return -1;
+		}
+		decoder->buffer = buffer;
+		decoder->capacity = capacity;
+	}
+	
+	memcpy(decoder->buffer + decoder->end, bytes, count);
+	decoder->end += count;
+	return 0;
+}
+
+int SPSOpenDecoderNextFrame(SPSOpenDecoder *decoder, const uint8_t **payload, uint32_t *length) {
+	size_t available = decoder->end - decoder->start;
+	if (available < 4) {
+		return 0;
+	}
+	
+	uint32_t frameLength = SPSOpenReadUInt32(decoder->buffer + decoder->start);
+	if (frameLength > SPS_OPEN_MAXIMUM_FRAME_LENGTH) {
+		return -1;
+	}
+	if (available - 4 < frameLength) {
+		return 0;
+	}
+	
+	*payload = decoder->buffer + decoder->start + 4;
+	*length = frameLength;
+	decoder->start += 4 + frameLength;
+	return 1;
+}
+
+void SPSOpenEncodeLength(uint32_t length, uint8_t prefix[4]) {
+	SPSOpenWriteUInt32(length, prefix);
+}
+
+void SPSOpenEncodeAcknowledgement(uint32_t openedCount, uint32_t failedCount, uint8_t frame[4 + SPS_OPEN_ACKNOWLEDGEMENT_LENGTH]) {
+	SPSOpenWriteUInt32(SPS_OPEN_ACKNOWLEDGEMENT_LENGTH, frame);
+	SPSOpenWriteUInt32(openedCount, frame + 4);
+	SPSOpenWriteUInt32(failedCount, frame + 8);
+}
+
+int SPSOpenDecodeAcknowledgement(const uint8_t *payload, uint32_t length, uint32_t *openedCount, uint32_t *failedCount) {
+	if (length != SPS_OPEN_ACKNOWLEDGEMENT_LENGTH) {
+		return -1;
+	}
+	
+	*openedCount = SPSOpenReadUInt32(payload);
+	*failedCount = SPSOpenReadUInt32(payload + 4);
+	return 0;
+}
@@ -0,0 +1,111 @@
+//
+//  SPSOpenProtocol.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef SPS_OPEN_PROTOCOL_H
+#define SPS_OPEN_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+ * The protocol spoken between sps-open and the agent over a Unix-domain socket. It is plain C, without anything from Mac OS X, so that the client and the framing can be built and tried anywhere.
+ *
+ * Everything is sent as frames: a 32-bit big-endian length followed by that many bytes. The client sends a batch as one frame per URL, in UTF-8, followed by an empty frame. It may send further batches without waiting. The agent acknowledges every batch, in order, once all of its URLs have been dispatched, with a frame holding two 32-bit big-endian counts: the URLs that were opened and the ones that failed.
+ */
+
+
+/**
+ * The name of the socket in the agent's caches folder.
+ */
+#define SPS_OPEN_SOCKET_NAME "open.sock"
+
+/**
+ * The largest frame either side accepts, in bytes.
+ */
+#define SPS_OPEN_MAXIMUM_FRAME_LENGTH 65536
+
+/**
+ * The length of an acknowledgement frame, in bytes.
+ */
+#define SPS_OPEN_ACKNOWLEDGEMENT_LENGTH 8
+
+/**
+ * The number of batches a client should have outstanding at most, so that neither side blocks on a full socket while the other is writing too.
+ */
+#define SPS_OPEN_MAXIMUM_OUTSTANDING_BATCHES 16
+
+
+/**
+ * Collects bytes as they arrive and cuts them into frames.
+ */
+typedef struct {
+	uint8_t *buffer;
+	size_t start;
+	size_t end;
+	size_t capacity;
+} SPSOpenDecoder;
+
+
+/**
+ * Initializes an empty decoder.
+ */
+void SPSOpenDecoderInit(SPSOpenDecoder *decoder);
+
+/**
+ * Frees the buffer of a decoder.
+ */
+void SPSOpenDecoderDestroy(SPSOpenDecoder *decoder);
+
+/**
+ * Appends received bytes to a decoder. Frames that were returned before are no longer valid afterwards.
+ *
+ * @return 0 on success, or -1 if the buffer could not be grown.
+ */
+int SPSOpenDecoderAppend(SPSOpenDecoder *decoder, const void *bytes, size_t count);
+
+/**
+ * Takes the next complete frame from a decoder.
+ *
+ * @param payload Set to the bytes of the frame, which stay valid until bytes are appended.
+ * @param length Set to the length of the frame.
+ * @return 1 if a frame was taken, 0 if more bytes are needed, or -1 if the stream is malformed.
+ */
+int SPSOpenDecoderNextFrame(SPSOpenDecoder *decoder, const uint8_t **payload, uint32_t *length);
+
+/**
+ * Writes the length prefix of a frame.
+ */
+void SPSOpenEncodeLength(uint32_t length, uint8_t prefix[4]);
+
+/**
+ * Writes an acknowledgement frame, including its length prefix.
+ */
+void SPSOpenEncodeAcknowledgement(uint32_t openedCount, uint32_t failedCount, uint8_t frame[4 + SPS_OPEN_ACKNOWLEDGEMENT_LENGTH]);
+
+/**
+ * Reads the counts of an acknowledgement.
+ *
+ * @return 0 on success, or -1 if the frame is not an acknowledgement.
+ */
+int SPSOpenDecodeAcknowledgement(const uint8_t *payload, uint32_t length, uint32_t *openedCount, uint32_t *failedCount);
+
+#endif
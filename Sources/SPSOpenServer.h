@@ -0,0 +1,81 @@
+//
+//  SPSOpenServer.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+@class SPSOpenServer, SPSURLRequest;
+
+
+/**
+ * The user defaults key of the path of the socket that sps-open streams URLs to. Defaults to open.sock in the application's caches folder; an empty path turns the socket off.
+ */
+#define SPS_OPEN_SOCKET_DEFAULT @"OpenSocket"
+
+
+/**
+ * Receives the URLs that clients stream to an open server. Called on the main thread.
+ */
+@protocol SPSOpenServerDelegate <NSObject>
+
+/**
+ * Called for every URL a client sent. The server acknowledges the batch of the URL once the completion handler of every request in it has been called.
+ *
+ * @param request A request without a suspended Apple Event, with a completion handler set by the server.
+ */
+- (void)openServer:(SPSOpenServer *)server didReceiveRequest:(SPSURLRequest *)request;
+
+@end
+
+
+/**
+ * Takes URLs from sps-open over a Unix-domain socket, speaking the protocol in SPSOpenProtocol.h, and hands them to its delegate as requests.
+ *
+ * Clients are read on the main queue as their bytes arrive, so that a stream of thousands of URLs reaches the coalescer in the same bursts as it was written, rather than one event at a time.
+ */
+@interface SPSOpenServer : NSObject {
+	id <SPSOpenServerDelegate> delegate;
+	NSString *path;
+	int socketDescriptor;
+	dispatch_source_t source;
+	NSMutableSet *connections;
+}
+
+/**
+ * Initializes the server and starts listening, replacing any socket left at the given path. The socket is only accessible to the current user.
+ *
+ * @param aPath The path of the socket, may not be nil.
+ * @param aDelegate The delegate, which is not retained.
+ * @return The server, or nil if the socket could not be set up.
+ */
+- (id)initWithPath:(NSString *)aPath delegate:(id <SPSOpenServerDelegate>)aDelegate;
+
+/**
+ * Stops listening, drops all clients and removes the socket. Must be called before the server is released.
+ */
+- (void)invalidate;
+
+/**
+ * Returns the default path of the socket.
+ */
++ (NSString *)defaultPath;
+
+@end
@@ -0,0 +1,383 @@
+//
+//  SPSOpenServer.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSOpenServer.h"
+#import "SPSOpenProtocol.h"
+#import "SPSURLRequest.h"
+#import "SPSMetrics.h"
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+/**
+ * The number of bytes read from a client at a time.
+ */
+#define SPS_OPEN_READ_LENGTH 65536
+
+
+/**
+ * The URLs of a batch, counted as their requests complete.
+ */
+@interface SPSOpenBatch : NSObject {
+@public
+	NSUInteger requestCount;
+	NSUInteger completedCount;
+	NSUInteger failedCount;
+	BOOL ended;
+}
+
+@end
+
+
+/**
+ * A client of the server.
+ */
+@interface SPSOpenConnection : NSObject {
+	SPSOpenServer *server;
+	id <SPSOpenServerDelegate> delegate;
+	int socketDescriptor;
+	dispatch_source_t source;
+	SPSOpenDecoder decoder;
+	NSMutableArray *batches;
+	NSMutableSet *pendingRequests;
+}
+
+/**
+ * Initializes the connection and starts reading from it on the main queue.
+ *
+ * @param aSocketDescriptor The accepted socket, which is closed along with the connection.
+ */
+- (id)initWithSocketDescriptor:(int)aSocketDescriptor server:(SPSOpenServer *)aServer delegate:(id <SPSOpenServerDelegate>)aDelegate;
+
+/**
+ * Stops reading and closes the socket. Requests that have not been dispatched yet are cancelled, since there is no one left to open them for.
+ */
+- (void)close;
+
+@end
+
+
+@interface SPSOpenServer ()
+
+/**
+ * Accepts a pending client.
+ */
+- (void)acceptConnection;
+
+/**
+ * Forgets a client that has closed.
+ */
+- (void)connectionDidClose:(SPSOpenConnection *)connection;
+
+@end
+
+
+@interface SPSOpenConnection ()
+
+/**
+ * Reads what the client has sent and hands over its URLs.
+ */
+- (void)readFrames;
+
+/**
+ * Hands a URL to the delegate as part of the last batch.
+ */
+- (void)receiveURLWithBytes:(const uint8_t *)bytes length:(uint32_t)length;
+
+/**
+ * Accounts for a request of the given batch that has completed.
+ */
+- (void)request:(SPSURLRequest *)request didCompleteInBatch:(SPSOpenBatch *)batch;
+
+/**
+ * Acknowledges the batches at the front that are done, in the order they were sent.
+ */
+- (void)sendAcknowledgements;
+
+@end
+
+
+@implementation SPSOpenBatch
+
+@end
+
+
+@implementation SPSOpenServer
+
++ (NSString *)defaultPath {
+	NSString *cachesPath = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) lastObject];
+	return [[cachesPath stringByAppendingPathComponent:[[NSBundle mainBundle] bundleIdentifier]] stringByAppendingPathComponent:@SPS_OPEN_SOCKET_NAME];
+}
+
+- (id)initWithPath:(NSString *)aPath delegate:(id <SPSOpenServerDelegate>)aDelegate {
+	if ((self = [super init])) {
+		delegate = aDelegate;
+		path = [aPath copy];
+		connections = [[NSMutableSet alloc] init];
+		
+		struct sockaddr_un address;
+		memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		if (![path getFileSystemRepresentation:address.sun_path maxLength:sizeof(address.sun_path)]) {
+			socketDescriptor = -1;
+			[self release];
+			return nil;
+		}
+		
+		[[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:NULL];
+		unlink(address.sun_path);
+		
+		// Only the user can connect, since anyone who can would be able to open pages in their Safari
+		socketDescriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (socketDescriptor == -1 || bind(socketDescriptor, (struct sockaddr *)&address, sizeof(address)) != 0 || chmod(address.sun_path, S_IRUSR | S_IWUSR) != 0 || listen(socketDescriptor, 8) != 0) {
+			[self release];
+			return nil;
+		}
+		
+		// Requests are handed over on the main thread, so clients are accepted there as well
+		source = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, socketDescriptor, 0, dispatch_get_main_queue());
+		
+		// The source keeps the server around until it has been cancelled, so that no handler outlives it
+		__block SPSOpenServer *server = [self retain];
+		dispatch_source_set_event_handler(source, ^{
+			[server acceptConnection];
+		});
+		
+		int listeningDescriptor = socketDescriptor;
+		dispatch_source_set_cancel_handler(source, ^{
+			close(listeningDescriptor);
+			[server release];
+		});
+		dispatch_resume(source);
+	}
+	return self;
+}
+
+- (void)dealloc {
+	// Once the source is set up, its cancel handler closes the socket
+	if (source == NULL && socketDescriptor != -1) {
+		close(socketDescriptor);
+	}
+	[path release];
+	[connections release];
+	[super dealloc];
+}
+
+- (void)invalidate {
+	if (source != NULL) {
+		dispatch_source_cancel(source);
+		dispatch_release(source);
+		source = NULL;
+		socketDescriptor = -1;
+		
+		unlink([path fileSystemRepresentation]);
+	}
+	
+	for (SPSOpenConnection *connection in [[connections copy] autorelease]) {
+		[connection close];
+	}
+	delegate = nil;
+}
+
+#pragma mark SPSOpenServer
+
+- (void)acceptConnection {
+	int connectionDescriptor = accept(socketDescriptor, NULL, NULL);
+	if (connectionDescriptor == -1) {
+		return;
+	}
+	
+	SPSCounterAdd(SPSCounterSocketConnections, 1);
+	SPSOpenConnection *connection = [[SPSOpenConnection alloc] initWithSocketDescriptor:connectionDescriptor server:self delegate:delegate];
+	[connections addObject:connection];
+	[connection release];
+}
+
+- (void)connectionDidClose:(SPSOpenConnection *)connection {
+	[connections removeObject:connection];
+}
+
+@end
+
+
+@implementation SPSOpenConnection
+
+- (id)initWithSocketDescriptor:(int)aSocketDescriptor server:(SPSOpenServer *)aServer delegate:(id <SPSOpenServerDelegate>)aDelegate {
+	if ((self = [super init])) {
+		server = aServer;
+		delegate = aDelegate;
+		socketDescriptor = aSocketDescriptor;
+		SPSOpenDecoderInit(&decoder);
+		batches = [[NSMutableArray alloc] init];
+		pendingRequests = [[NSMutableSet alloc] init];
+		
+		// Neither side should be able to hold up the main thread, nor kill us by going away
+		int noSignal = 1;
+		setsockopt(socketDescriptor, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+		fcntl(socketDescriptor, F_SETFL, fcntl(socketDescriptor, F_GETFL) | O_NONBLOCK);
+		
+		source = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, socketDescriptor, 0, dispatch_get_main_queue());
+		
+		// Likewise, the source keeps the connection around until it has been cancelled
+		__block SPSOpenConnection *connection = [self retain];
+		dispatch_source_set_event_handler(source, ^{
+			[connection readFrames];
+		});
+		
+		int connectionDescriptor = socketDescriptor;
+		dispatch_source_set_cancel_handler(source, ^{
+			close(connectionDescriptor);
+			[connection release];
+		});
+		dispatch_resume(source);
+	}
+	return self;
+}
+
+- (void)dealloc {
+	SPSOpenDecoderDestroy(&decoder);
+	[batches release];
+	[pendingRequests release];
+	[super dealloc];
+}
+
+- (void)close {
+	if (source == NULL) {
+		return;
+	}
+	
+	dispatch_source_cancel(source);
+	dispatch_release(source);
+	source = NULL;
+	socketDescriptor = -1;
+	delegate = nil;
+	
+	[pendingRequests makeObjectsPerformSelector:@selector(cancel)];
+	
+	// Requests that are underway keep the connection around until they complete
+	[[self retain] autorelease];
+	[server connectionDidClose:self];
+	server = nil;
+}
+
+#pragma mark SPSOpenConnection
+
+- (void)readFrames {
+	uint8_t bytes[SPS_OPEN_READ_LENGTH];
+	ssize_t count = read(socketDescriptor, bytes, sizeof(bytes));
+	if (count < 0 && (errno == EAGAIN || errno == EINTR)) {
+		return;
+	}
+	if (count <= 0 || SPSOpenDecoderAppend(&decoder, bytes, (size_t)count) != 0) {
+		[self close];
+		return;
+	}
+	
+	const uint8_t *payload;
+	uint32_t length;
+	int status;
+	while ((status = SPSOpenDecoderNextFrame(&decoder, &payload, &length)) == 1) {
+		if (length > 0) {
+			[self receiveURLWithBytes:payload length:length];
+		}
+		else if ([batches count] > 0 && !((SPSOpenBatch *)[batches lastObject])->ended) {
+			((SPSOpenBatch *)[batches lastObject])->ended = YES;
+		}
+		else {
+			// An empty batch is acknowledged right away
+			SPSOpenBatch *batch = [[SPSOpenBatch alloc] init];
+			batch->ended = YES;
+			[batches addObject:batch];
+			[batch release];
+		}
+	}
+	
+	if (status < 0) {
+		[self close];
+		return;
+	}
+	
+	[self sendAcknowledgements];
+}
+
+- (void)receiveURLWithBytes:(const uint8_t *)bytes length:(uint32_t)length {
+	SPSOpenBatch *batch = [batches lastObject];
+	if (batch == nil || batch->ended) {
+		batch = [[[SPSOpenBatch alloc] init] autorelease];
+		[batches addObject:batch];
+	}
+	batch->requestCount++;
+	
+	NSString *URLString = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+	NSURL *URL = (URLString != nil) ? [NSURL URLWithString:URLString] : nil;
+	[URLString release];
+	
+	if (URL == nil) {
+		batch->completedCount++;
+		batch->failedCount++;
+		return;
+	}
+	
+	SPSCounterAdd(SPSCounterSocketURLs, 1);
+	SPSURLRequest *request = [[SPSURLRequest alloc] initWithURL:URL suspensionID:NULL deadline:[NSDate timeIntervalSinceReferenceDate] + SPS_URL_REQUEST_BUDGET];
+	[request setCompletionHandler:^(SPSURLRequest *completedRequest) {
+		[self request:completedRequest didCompleteInBatch:batch];
+	}];
+	[pendingRequests addObject:request];
+	[delegate openServer:server didReceiveRequest:request];
+	[request release];
+}
+
+- (void)request:(SPSURLRequest *)request didCompleteInBatch:(SPSOpenBatch *)batch {
+	[pendingRequests removeObject:request];
+	batch->completedCount++;
+	
+	if ([request error] != nil) {
+		batch->failedCount++;
+	}
+	
+	[self sendAcknowledgements];
+}
+
+- (void)sendAcknowledgements {
+	while (socketDescriptor != -1 && [batches count] > 0) {
+		SPSOpenBatch *batch = [batches objectAtIndex:0];
+		if (!batch->ended || batch->completedCount < batch->requestCount) {
+			return;
+		}
+		
+		// A client keeps few enough batches outstanding that their acknowledgements always fit, so one that does not is broken
+		uint8_t frame[4 + SPS_OPEN_ACKNOWLEDGEMENT_LENGTH];
+		SPSOpenEncodeAcknowledgement((uint32_t)(batch->requestCount - batch->failedCount), (uint32_t)batch->failedCount, frame);
+		if (write(socketDescriptor, frame, sizeof(frame)) != sizeof(frame)) {
+			[self close];
+			return;
+		}
+		
+		[batches removeObjectAtIndex:0];
+	}
+}
+
+@end
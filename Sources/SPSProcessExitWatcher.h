@@ -0,0 +1,56 @@
+//
+//  SPSProcessExitWatcher.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ * Watches a process and calls a handler the moment it exits, without polling or waiting for Apple Events to time out.
+ *
+ * On Mac OS X the kernel reports the exit through a kqueue process filter. On Linux, which has no such filter, it is reported through a process file descriptor, which becomes readable when the process exits.
+ */
+@interface SPSProcessExitWatcher : NSObject {
+	pid_t processIdentifier;
+	dispatch_source_t source;
+	BOOL cancelled;
+}
+
+/**
+ * Initializes the watcher and starts watching.
+ *
+ * If the process has already exited, the handler is called right away.
+ *
+ * @param aProcessIdentifier The process to watch.
+ * @param handler The block to call on the main queue when the process exits, may not be nil. It is called at most once.
+ */
+- (id)initWithProcessIdentifier:(pid_t)aProcessIdentifier handler:(void (^)(pid_t processIdentifier))handler;
+
+/**
+ * Stops watching, so that the handler is no longer called, not even for an exit that was already seen but not yet handled.
+ */
+- (void)cancel;
+
+/**
+ * The watched process.
+ */
+- (pid_t)processIdentifier;
+
+@end
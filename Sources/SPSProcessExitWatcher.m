@@ -0,0 +1,130 @@
+//
+//  SPSProcessExitWatcher.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSProcessExitWatcher.h"
+#import <signal.h>
+#import <errno.h>
+#ifdef __linux__
+#import <sys/syscall.h>
+#import <unistd.h>
+#endif
+
+
+#if defined(__linux__) && !defined(SYS_pidfd_open)
+/**
+ * The number of the pidfd_open system call, for C libraries that predate it. It is the same on every architecture.
+ */
+#define SYS_pidfd_open 434
+#endif
+
+
+@interface SPSProcessExitWatcher ()
+
+/**
+ * Stops the dispatch source, if any.
+ */
+- (void)stopWatching;
+
+/**
+ * Calls the handler for the watched process on the main queue, unless the watcher is cancelled before then.
+ */
+- (void)reportExitWithHandler:(void (^)(pid_t processIdentifier))handler;
+
+@end
+
+
+@implementation SPSProcessExitWatcher
+
+- (id)initWithProcessIdentifier:(pid_t)aProcessIdentifier handler:(void (^)(pid_t processIdentifier))handler {
+	if ((self = [super init])) {
+		processIdentifier = aProcessIdentifier;
+		
+#ifdef __linux__
+		// A process file descriptor becomes readable once the process has exited, which is as soon as the kernel can tell us
+		int processFileDescriptor = (int)syscall(SYS_pidfd_open, processIdentifier, 0);
+		if (processFileDescriptor >= 0) {
+			source = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, processFileDescriptor, 0, dispatch_get_main_queue());
+			if (source != NULL) {
+				dispatch_source_set_cancel_handler(source, ^{
+					close(processFileDescriptor);
+				});
+			}
+			else {
+				close(processFileDescriptor);
+			}
+		}
+#else
+		// The dispatch source is backed by a kqueue process filter, so the kernel tells us as soon as the process is gone
+		source = dispatch_source_create(DISPATCH_SOURCE_TYPE_PROC, processIdentifier, DISPATCH_PROC_EXIT, dispatch_get_main_queue());
+#endif
+		if (source != NULL) {
+			dispatch_source_t exitSource = source;
+			pid_t exitedProcessIdentifier = processIdentifier;
+			
+			dispatch_source_set_event_handler(source, ^{
+				dispatch_source_cancel(exitSource);
+				handler(exitedProcessIdentifier);
+			});
+			dispatch_resume(source);
+		}
+		
+		// The process may have exited before the source was set up, in which case no event will come
+		if (source == NULL || (kill(processIdentifier, 0) != 0 && errno == ESRCH)) {
+			[self stopWatching];
+			[self reportExitWithHandler:handler];
+		}
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[self cancel];
+	[super dealloc];
+}
+
+- (void)cancel {
+	cancelled = YES;
+	[self stopWatching];
+}
+
+- (pid_t)processIdentifier {
+	return processIdentifier;
+}
+
+- (void)stopWatching {
+	if (source != NULL) {
+		dispatch_source_cancel(source);
+		dispatch_release(source);
+		source = NULL;
+	}
+}
+
+- (void)reportExitWithHandler:(void (^)(pid_t processIdentifier))handler {
+	// The block keeps the watcher around, so that a watcher that was cancelled and let go of meanwhile can still tell
+	dispatch_async(dispatch_get_main_queue(), ^{
+		if (!cancelled) {
+			cancelled = YES;
+			handler(processIdentifier);
+		}
+	});
+}
+
+@end
@@ -0,0 +1,103 @@
+//
+//  SPSProcessRegistry.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+@protocol SPSProcessBackend;
+
+
+/**
+ * Receives launch and termination events from a process backend.
+ */
+@protocol SPSProcessBackendDelegate <NSObject>
+
+/**
+ * Called when a process has been launched.
+ *
+ * @param processIdentifier The Unix process identifier of the new process.
+ * @param bundleIdentifier The bundle identifier of the new process, may not be nil.
+ */
+- (void)processBackend:(id <SPSProcessBackend>)backend didLaunchProcessWithIdentifier:(pid_t)processIdentifier bundleIdentifier:(NSString *)bundleIdentifier;
+
+/**
+ * Called when a process has terminated.
+ *
+ * @param processIdentifier The Unix process identifier of the terminated process.
+ */
+- (void)processBackend:(id <SPSProcessBackend>)backend didTerminateProcessWithIdentifier:(pid_t)processIdentifier;
+
+@end
+
+
+/**
+ * A source of running processes, such as the workspace or a fake process table.
+ */
+@protocol SPSProcessBackend <NSObject>
+
+/**
+ * The object that is told about launched and terminated processes. Not retained.
+ */
+- (id <SPSProcessBackendDelegate>)delegate;
+- (void)setDelegate:(id <SPSProcessBackendDelegate>)delegate;
+
+/**
+ * Calls the given block once for every process that is currently running and has a bundle identifier.
+ */
+- (void)enumerateProcessesUsingBlock:(void (^)(pid_t processIdentifier, NSString *bundleIdentifier))block;
+
+@end
+
+
+/**
+ * Keeps track of running processes by bundle identifier and process identifier, without sending any Apple Events.
+ */
+@interface SPSProcessRegistry : NSObject <SPSProcessBackendDelegate> {
+	id <SPSProcessBackend> backend;
+	NSMutableDictionary *processIdentifiersByBundleIdentifier;
+	NSMutableDictionary *bundleIdentifiersByProcessIdentifier;
+}
+
+/**
+ * Initializes the registry with the processes that the given backend reports as running.
+ *
+ * @param aBackend A process backend, may not be nil. It is retained and its delegate is set to the registry.
+ */
+- (id)initWithBackend:(id <SPSProcessBackend>)aBackend;
+
+/**
+ * Returns the process identifier of the most recently launched process with the given bundle identifier, or 0 if no such process is running.
+ *
+ * @param bundleIdentifier A bundle identifier, may not be nil.
+ */
+- (pid_t)processIdentifierForBundleIdentifier:(NSString *)bundleIdentifier;
+
+/**
+ * Forgets the given process, if it is known. Useful for processes known to have exited before the backend reports it.
+ */
+- (void)removeProcessWithIdentifier:(pid_t)processIdentifier;
+
+/**
+ * Forgets all processes and asks the backend for the current ones again.
+ */
+- (void)reload;
+
+@end
@@ -0,0 +1,111 @@
+//
+//  SPSProcessRegistry.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSProcessRegistry.h"
+
+
+@interface SPSProcessRegistry ()
+
+/**
+ * Records the given process.
+ */
+- (void)addProcessWithIdentifier:(pid_t)processIdentifier bundleIdentifier:(NSString *)bundleIdentifier;
+@end
+
+
+@implementation SPSProcessRegistry
+
+- (id)initWithBackend:(id <SPSProcessBackend>)aBackend {
+	if ((self = [super init])) {
+		backend = [aBackend retain];
+		processIdentifiersByBundleIdentifier = [[NSMutableDictionary alloc] init];
+		bundleIdentifiersByProcessIdentifier = [[NSMutableDictionary alloc] init];
+
+		[backend setDelegate:self];
+		[self reload];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[backend setDelegate:nil];
+	[backend release];
+	[processIdentifiersByBundleIdentifier release];
+	[bundleIdentifiersByProcessIdentifier release];
+	[super dealloc];
+}
+
+#pragma mark SPSProcessBackendDelegate
+
+- (void)processBackend:(id <SPSProcessBackend>)aBackend didLaunchProcessWithIdentifier:(pid_t)processIdentifier bundleIdentifier:(NSString *)bundleIdentifier {
+	[self addProcessWithIdentifier:processIdentifier bundleIdentifier:bundleIdentifier];
+}
+
+- (void)processBackend:(id <SPSProcessBackend>)aBackend didTerminateProcessWithIdentifier:(pid_t)processIdentifier {
+	[self removeProcessWithIdentifier:processIdentifier];
+}
+
+#pragma mark SPSProcessRegistry
+
+- (pid_t)processIdentifierForBundleIdentifier:(NSString *)bundleIdentifier {
+	NSNumber *processIdentifier = [[processIdentifiersByBundleIdentifier objectForKey:bundleIdentifier] lastObject];
+	return (processIdentifier != nil) ? [processIdentifier intValue] : 0;
+}
+
+- (void)reload {
+	[processIdentifiersByBundleIdentifier removeAllObjects];
+	[bundleIdentifiersByProcessIdentifier removeAllObjects];
+
+	[backend enumerateProcessesUsingBlock:^(pid_t processIdentifier, NSString *bundleIdentifier) {
+		[self addProcessWithIdentifier:processIdentifier bundleIdentifier:bundleIdentifier];
+	}];
+}
+
+- (void)addProcessWithIdentifier:(pid_t)processIdentifier bundleIdentifier:(NSString *)bundleIdentifier {
+	NSNumber *key = [NSNumber numberWithInt:processIdentifier];
+
+	// A process identifier can only belong to one process at a time
+	[self removeProcessWithIdentifier:processIdentifier];
+
+	NSMutableArray *processIdentifiers = [processIdentifiersByBundleIdentifier objectForKey:bundleIdentifier];
+	if (processIdentifiers == nil) {
+		processIdentifiers = [NSMutableArray array];
+		[processIdentifiersByBundleIdentifier setObject:processIdentifiers forKey:bundleIdentifier];
+	}
+	[processIdentifiers addObject:key];
+	[bundleIdentifiersByProcessIdentifier setObject:bundleIdentifier forKey:key];
+}
+
+- (void)removeProcessWithIdentifier:(pid_t)processIdentifier {
+	NSNumber *key = [NSNumber numberWithInt:processIdentifier];
+	NSString *bundleIdentifier = [bundleIdentifiersByProcessIdentifier objectForKey:key];
+
+	if (bundleIdentifier != nil) {
+		NSMutableArray *processIdentifiers = [processIdentifiersByBundleIdentifier objectForKey:bundleIdentifier];
+		[processIdentifiers removeObject:key];
+		if ([processIdentifiers count] == 0) {
+			[processIdentifiersByBundleIdentifier removeObjectForKey:bundleIdentifier];
+		}
+		[bundleIdentifiersByProcessIdentifier removeObjectForKey:key];
+	}
+}
+
+@end
@@ -0,0 +1,140 @@
+//
+//  SPSReplayBenchmark.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Cocoa/Cocoa.h>
+#import "SPSApplicationController.h"
+
+
+@class SPSFakeSafari, SPSFakeProcessTable;
+
+
+/**
+ * The user defaults key of the time each command to the fake Safari takes during a replay, in milliseconds.
+ */
+#define SPS_REPLAY_LATENCY_DEFAULT @"ReplayLatency"
+
+/**
+ * The user defaults key of the factor by which to speed up a replayed event log. Defaults to 1.
+ */
+#define SPS_REPLAY_SPEED_DEFAULT @"ReplaySpeed"
+
+/**
+ * The user defaults key of whether the controller of a replay keeps a pool of windows. Unlike SPS_WINDOW_POOL_DEFAULT, which is left to the agent.
+ */
+#define SPS_REPLAY_WINDOW_POOL_DEFAULT @"ReplayWindowPool"
+
+/**
+ * The name of a replay that asks for a generated one, instead of the path of a file.
+ */
+#define SPS_SYNTHETIC_REPLAY @"synthetic"
+
+/**
+ * The keys of an event: its time since the start of the replay as an NSNumber, its kind, and its URL or space identifier as a string, if any.
+ */
+#define SPS_EVENT_TIME_KEY @"time"
+#define SPS_EVENT_KIND_KEY @"kind"
+#define SPS_EVENT_ARGUMENT_KEY @"argument"
+
+/**
+ * The kinds of events.
+ */
+#define SPS_URL_EVENT @"url"
+#define SPS_ACTIVATE_EVENT @"activate"
+#define SPS_SPACE_EVENT @"space"
+#define SPS_STALL_EVENT @"stall"
+#define SPS_RECOVER_EVENT @"recover"
+#define SPS_QUIT_EVENT @"quit"
+
+
+/**
+ * Replays a stream of URLs, activations and space switches against a controller that talks to a fake Safari, and reports how the controller kept up.
+ *
+ * Events can also be replayed from an event log, which is recognized by its extension.
+ *
+ * A replay file has one event per line: the time since the start of the replay in seconds, followed by "url" and a URL, "activate", "space" and a space identifier, "stall" or "recover", which make the fake Safari stop and start answering again, or "quit", which quits it until it is activated again. Empty lines and lines starting with # are skipped.
+ *
+ * Once every URL has been dispatched, the latency from event to dispatch, the number of commands per URL and the throughput are written to standard output, and the tool is terminated.
+ */
+@interface SPSReplayBenchmark : NSObject {
+	NSArray *events;
+	SPSFakeSafari *fakeSafari;
+	SPSFakeProcessTable *processTable;
+	SPSApplicationController *controller;
+	NSUInteger remainingEventCount;
+	NSUInteger pendingURLCount;
+	NSUInteger failedURLCount;
+	NSMutableArray *latencies;
+	NSTimeInterval startTime;
+	NSTimeInterval endTime;
+}
+
+/**
+ * Reads or generates the events of a replay: generated ones for "synthetic", an event log if the extension says so, or else a replay file.
+ *
+ * @param replay "synthetic" or a path.
+ * @param speed The factor by which to speed up an event log.
+ * @return An array of events, or nil if the replay could not be read.
+ */
++ (NSArray *)eventsWithContentsOfReplay:(NSString *)replay speed:(double)speed;
+
+/**
+ * Reads the events of a replay file.
+ *
+ * @return An array of events, or nil if the file could not be read or has a malformed line.
+ */
++ (NSArray *)eventsWithContentsOfFile:(NSString *)path;
+
+/**
+ * Parses a line of a replay file.
+ *
+ * @param line A line without surrounding whitespace.
+ * @return An event, or nil if the line is malformed.
+ */
++ (NSDictionary *)eventWithLine:(NSString *)line;
+
+/**
+ * Reads the events of an event log written by SPSEventRecorder. A space switch is inserted wherever the recorded active space changes.
+ *
+ * @param speed The factor by which to speed up the recorded times, where 1 replays at the recorded speed.
+ * @return An array of events, or nil if the log could not be read.
+ */
++ (NSArray *)eventsWithContentsOfEventLog:(NSString *)path speed:(double)speed;
+
+/**
+ * Generates a replay of bursts of URLs across a few spaces, with space switches and activations in between. The same replay is generated every time.
+ */
++ (NSArray *)syntheticEvents;
+
+/**
+ * Initializes the benchmark with a controller of its own.
+ *
+ * @param someEvents Events as returned by eventsWithContentsOfFile: or syntheticEvents.
+ * @param latency The time each command to the fake Safari takes, in seconds.
+ * @param settings The settings of the controller. Events are never recorded, whatever the settings say.
+ */
+- (id)initWithEvents:(NSArray *)someEvents latency:(NSTimeInterval)latency settings:(SPSControllerSettings)settings;
+
+/**
+ * Schedules the events on the main run loop, starting now.
+ */
+- (void)start;
+
+@end
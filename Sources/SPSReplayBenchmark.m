@@ -0,0 +1,337 @@
+//
+//  SPSReplayBenchmark.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSReplayBenchmark.h"
+#import "SPSFakeSafari.h"
+#import "SPSFakeProcessTable.h"
+#import "SPSApplicationController.h"
+#import "SPSSafariDriver.h"
+#import "SPSURLRequest.h"
+#import "SPSEventLogReader.h"
+#import "SPSEventRecorder.h"
+#include <math.h>
+
+
+/**
+ * The shape of the synthetic replay.
+ */
+#define SPS_SYNTHETIC_REPLAY_BURSTS 100
+#define SPS_SYNTHETIC_REPLAY_SPACES 4
+#define SPS_SYNTHETIC_REPLAY_BURST_INTERVAL 0.25
+#define SPS_SYNTHETIC_REPLAY_URL_INTERVAL 0.005
+
+
+@interface SPSReplayBenchmark ()
+
+/**
+ * Returns an event.
+ */
++ (NSDictionary *)eventAtTime:(NSTimeInterval)time kind:(NSString *)kind argument:(NSString *)argument;
+
+/**
+ * Delivers an event to the controller.
+ */
+- (void)replayEvent:(NSDictionary *)event;
+
+/**
+ * Accounts for a URL that has been dispatched.
+ *
+ * @param receiveTime The time at which the URL was handed to the controller.
+ */
+- (void)requestDidComplete:(SPSURLRequest *)request receivedAtTime:(NSTimeInterval)receiveTime;
+
+/**
+ * Reports and terminates once all events have been delivered and all URLs have been dispatched.
+ */
+- (void)finishIfDone;
+
+/**
+ * Returns the latency below which the given fraction of URLs were dispatched, in microseconds. The latencies must be sorted.
+ */
+- (int64_t)latencyPercentile:(double)fraction;
+
+@end
+
+
+@implementation SPSReplayBenchmark
+
++ (NSArray *)eventsWithContentsOfReplay:(NSString *)replay speed:(double)speed {
+	if ([replay isEqualToString:SPS_SYNTHETIC_REPLAY]) {
+		return [self syntheticEvents];
+	}
+	if ([[replay pathExtension] isEqualToString:SPS_EVENT_LOG_EXTENSION]) {
+		return [self eventsWithContentsOfEventLog:replay speed:speed];
+	}
+	return [self eventsWithContentsOfFile:replay];
+}
+
++ (NSArray *)eventsWithContentsOfFile:(NSString *)path {
+	NSString *contents = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:NULL];
+	if (contents == nil) {
+		return nil;
+	}
+	
+	NSMutableArray *fileEvents = [NSMutableArray array];
+	
+	for (NSString *line in [contents componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]]) {
+		line = [line stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+		if ([line length] == 0 || [line hasPrefix:@"#"]) {
+			continue;
+		}
+		
+		NSDictionary *event = [self eventWithLine:line];
+		if (event == nil) {
+			return nil;
+		}
+		
+		[fileEvents addObject:event];
+	}
+	
+	return fileEvents;
+}
+
++ (NSDictionary *)eventWithLine:(NSString *)line {
+	NSCharacterSet *whitespaceCharacterSet = [NSCharacterSet whitespaceCharacterSet];
+	NSScanner *scanner = [NSScanner scannerWithString:line];
+	double time;
+	NSString *kind = nil;
+	NSString *argument = nil;
+	if (![scanner scanDouble:&time] || ![scanner scanUpToCharactersFromSet:whitespaceCharacterSet intoString:&kind]) {
+		return nil;
+	}
+	[scanner scanUpToString:@"\n" intoString:&argument];
+	
+	BOOL valid = NO;
+	if ([kind isEqualToString:SPS_URL_EVENT]) {
+		valid = (argument != nil && [NSURL URLWithString:argument] != nil);
+	}
+	else if ([kind isEqualToString:SPS_ACTIVATE_EVENT] || [kind isEqualToString:SPS_STALL_EVENT] || [kind isEqualToString:SPS_RECOVER_EVENT] || [kind isEqualToString:SPS_QUIT_EVENT]) {
+		valid = (argument == nil);
+	}
+	else if ([kind isEqualToString:SPS_SPACE_EVENT]) {
+		valid = (argument != nil && [argument integerValue] > 0);
+	}
+	if (!valid) {
+		return nil;
+	}
+	
+	return [self eventAtTime:time kind:kind argument:argument];
+}
+
++ (NSArray *)eventsWithContentsOfEventLog:(NSString *)path speed:(double)speed {
+	SPSEventLogReader *reader = [[SPSEventLogReader alloc] initWithPath:path];
+	if (reader == nil) {
+		return nil;
+	}
+	
+	NSMutableArray *logEvents = [NSMutableArray arrayWithCapacity:[reader count]];
+	__block int32_t spaceIdentifier = 0;
+	
+	[reader enumerateEventsUsingBlock:^(const SPSEventRecord *record, NSString *URLString) {
+		NSTimeInterval time = record->time / 1000000.0 / speed;
+		
+		// The fake Safari starts out in a space of its own, so the first recorded space is always switched to
+		if (record->spaceIdentifier != spaceIdentifier) {
+			spaceIdentifier = record->spaceIdentifier;
+			[logEvents addObject:[self eventAtTime:time kind:SPS_SPACE_EVENT argument:[NSString stringWithFormat:@"%ld", (long)spaceIdentifier]]];
+		}
+		
+		if (record->type == SPSEventTypeURL && URLString != nil) {
+			[logEvents addObject:[self eventAtTime:time kind:SPS_URL_EVENT argument:URLString]];
+		}
+		else if (record->type == SPSEventTypeActivation) {
+			[logEvents addObject:[self eventAtTime:time kind:SPS_ACTIVATE_EVENT argument:nil]];
+		}
+	}];
+	
+	[reader release];
+	return logEvents;
+}
+
++ (NSArray *)syntheticEvents {
+	NSMutableArray *syntheticEvents = [NSMutableArray array];
+	unsigned int seed = 1;
+	NSInteger spaceIdentifier = 1;
+	
+	for (NSUInteger burst = 0; burst < SPS_SYNTHETIC_REPLAY_BURSTS; burst++) {
+		NSTimeInterval time = burst * SPS_SYNTHETIC_REPLAY_BURST_INTERVAL;
+		
+		// Every so often the user moves to another space, or switches to Spatial Safari itself
+		if (burst % 8 == 7) {
+			spaceIdentifier = spaceIdentifier % SPS_SYNTHETIC_REPLAY_SPACES + 1;
+			[syntheticEvents addObject:[self eventAtTime:time kind:SPS_SPACE_EVENT argument:[NSString stringWithFormat:@"%ld", (long)spaceIdentifier]]];
+		}
+		else if (burst % 8 == 3) {
+			[syntheticEvents addObject:[self eventAtTime:time kind:SPS_ACTIVATE_EVENT argument:nil]];
+		}
+		
+		// Links mostly come one at a time, but sometimes a handful are opened at once
+		NSUInteger URLCount = 1 + rand_r(&seed) % 5;
+		for (NSUInteger index = 0; index < URLCount; index++) {
+			NSString *URLString = [NSString stringWithFormat:@"http://example.com/%lu/%lu", (unsigned long)burst, (unsigned long)index];
+			[syntheticEvents addObject:[self eventAtTime:time + index * SPS_SYNTHETIC_REPLAY_URL_INTERVAL kind:SPS_URL_EVENT argument:URLString]];
+		}
+	}
+	
+	return syntheticEvents;
+}
+
++ (NSDictionary *)eventAtTime:(NSTimeInterval)time kind:(NSString *)kind argument:(NSString *)argument {
+	return [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithDouble:time], SPS_EVENT_TIME_KEY, kind, SPS_EVENT_KIND_KEY, argument, SPS_EVENT_ARGUMENT_KEY, nil];
+}
+
+- (id)initWithEvents:(NSArray *)someEvents latency:(NSTimeInterval)latency settings:(SPSControllerSettings)settings {
+	if ((self = [super init])) {
+		events = [someEvents copy];
+		latencies = [[NSMutableArray alloc] initWithCapacity:[events count]];
+		
+		// The fake Safari runs from the start, with a process of its own whose exit the controller can watch
+		fakeSafari = [[SPSFakeSafari alloc] initWithLatency:latency];
+		[fakeSafari launch];
+		processTable = [[SPSFakeProcessTable alloc] init];
+		[processTable launchProcessWithIdentifier:[fakeSafari processIdentifier] bundleIdentifier:SAFARI_BUNDLE_IDENTIFIER];
+		settings.eventLogPath = nil;
+		controller = [[SPSApplicationController alloc] initWithProcessBackend:processTable windowListSource:fakeSafari scriptingEngine:fakeSafari settings:settings];
+		
+		// Tell the controller about new windows, like the accessibility notification for a real one would; the fake is owned by us, so its handler should not retain anything
+		__block SPSApplicationController *observingController = controller;
+		[fakeSafari setWindowCreationHandler:^(NSInteger windowIdentifier) {
+			dispatch_async(dispatch_get_main_queue(), ^{
+				[observingController windowObserver:nil didObserveCreationOfWindow:windowIdentifier];
+			});
+		}];
+		
+		// Tell the registry about a Safari that was launched again, like the workspace would
+		__block SPSFakeProcessTable *launchedProcessTable = processTable;
+		[fakeSafari setLaunchHandler:^(pid_t processIdentifier) {
+			dispatch_async(dispatch_get_main_queue(), ^{
+				[launchedProcessTable launchProcessWithIdentifier:processIdentifier bundleIdentifier:SAFARI_BUNDLE_IDENTIFIER];
+			});
+		}];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[NSObject cancelPreviousPerformRequestsWithTarget:self];
+	[events release];
+	[controller release];
+	[fakeSafari setWindowCreationHandler:nil];
+	[fakeSafari setLaunchHandler:nil];
+	[fakeSafari release];
+	[processTable release];
+	[latencies release];
+	[super dealloc];
+}
+
+- (void)start {
+	startTime = [NSDate timeIntervalSinceReferenceDate];
+	remainingEventCount = [events count];
+	
+	for (NSDictionary *event in events) {
+		[self performSelector:@selector(replayEvent:) withObject:event afterDelay:[[event objectForKey:SPS_EVENT_TIME_KEY] doubleValue]];
+	}
+	
+	[self finishIfDone];
+}
+
+#pragma mark SPSReplayBenchmark
+
+- (void)replayEvent:(NSDictionary *)event {
+	NSString *kind = [event objectForKey:SPS_EVENT_KIND_KEY];
+	NSString *argument = [event objectForKey:SPS_EVENT_ARGUMENT_KEY];
+	
+	if ([kind isEqualToString:SPS_URL_EVENT]) {
+		// Measure from the moment the URL reaches the controller, as the GetURL handler would
+		NSTimeInterval receiveTime = [NSDate timeIntervalSinceReferenceDate];
+		SPSURLRequest *request = [[SPSURLRequest alloc] initWithURL:[NSURL URLWithString:argument] suspensionID:NULL deadline:receiveTime + SPS_URL_REQUEST_BUDGET];
+		
+		__block SPSReplayBenchmark *benchmark = self;
+		[request setCompletionHandler:^(SPSURLRequest *completedRequest) {
+			[benchmark requestDidComplete:completedRequest receivedAtTime:receiveTime];
+		}];
+		
+		pendingURLCount++;
+		[controller openRequest:request];
+		[request release];
+	}
+	else if ([kind isEqualToString:SPS_ACTIVATE_EVENT]) {
+		[controller applicationWillBecomeActive:nil];
+	}
+	else if ([kind isEqualToString:SPS_SPACE_EVENT]) {
+		[fakeSafari setActiveSpaceIdentifier:[argument integerValue]];
+		[[[NSWorkspace sharedWorkspace] notificationCenter] postNotificationName:NSWorkspaceActiveSpaceDidChangeNotification object:[NSWorkspace sharedWorkspace]];
+	}
+	else if ([kind isEqualToString:SPS_STALL_EVENT] || [kind isEqualToString:SPS_RECOVER_EVENT]) {
+		[fakeSafari setStalled:[kind isEqualToString:SPS_STALL_EVENT]];
+	}
+	else if ([kind isEqualToString:SPS_QUIT_EVENT]) {
+		// The workspace is slow to report the exit, so the controller has to notice it on its own
+		[fakeSafari quit];
+	}
+	
+	remainingEventCount--;
+	[self finishIfDone];
+}
+
+- (void)requestDidComplete:(SPSURLRequest *)request receivedAtTime:(NSTimeInterval)receiveTime {
+	endTime = [NSDate timeIntervalSinceReferenceDate];
+	[latencies addObject:[NSNumber numberWithDouble:endTime - receiveTime]];
+	
+	if ([request error] != nil) {
+		failedURLCount++;
+	}
+	
+	pendingURLCount--;
+	[self finishIfDone];
+}
+
+- (void)finishIfDone {
+	if (remainingEventCount > 0 || pendingURLCount > 0) {
+		return;
+	}
+	
+	NSUInteger URLCount = [latencies count];
+	[latencies sortUsingSelector:@selector(compare:)];
+	
+	printf("urls %lu\n", (unsigned long)URLCount);
+	printf("failed_urls %lu\n", (unsigned long)failedURLCount);
+	printf("p50_dispatch_microseconds %lld\n", [self latencyPercentile:0.50]);
+	printf("p99_dispatch_microseconds %lld\n", [self latencyPercentile:0.99]);
+	printf("apple_events_per_url %.2f\n", (URLCount > 0) ? (double)[fakeSafari commandCount] / URLCount : 0.0);
+	printf("urls_per_second %.1f\n", (URLCount > 0 && endTime > startTime) ? URLCount / (endTime - startTime) : 0.0);
+	fflush(stdout);
+	
+	[NSApp terminate:nil];
+}
+
+- (int64_t)latencyPercentile:(double)fraction {
+	NSUInteger count = [latencies count];
+	if (count == 0) {
+		return 0;
+	}
+	
+	// Nearest rank
+	NSUInteger index = (NSUInteger)ceil(fraction * count) - 1;
+	return (int64_t)([[latencies objectAtIndex:MIN(index, count - 1)] doubleValue] * 1000000.0);
+}
+
+@end
@@ -0,0 +1,49 @@
+/*
+ * SPSSafariCodes.h
+ *
+ * Generated by Tools/sdefstubs.py for: application.documents, window.tabs, window.miniaturized, tab.URL, document.URL
+ * Do not edit; run the generator again instead.
+ */
+
+#import "SPSAppleEvents.h"
+
+
+enum {
+	SPSSafariApplicationClass = 'capp',
+	SPSSafariDocumentClass = 'docu',
+	SPSSafariWindowClass = 'cwin',
+	SPSSafariTabClass = 'bTab',
+	SPSSafariWindowMiniaturizedProperty = 'pmnd',
+	SPSSafariTabURLProperty = 'pURL',
+	SPSSafariDocumentURLProperty = 'pURL',
+};
+
+
+/**
+ * Returns a specifier for the "miniaturized" property of the given window.
+ *
+ * Whether the window is currently miniaturized.
+ */
+static inline NSAppleEventDescriptor *SPSSafariWindowMiniaturizedSpecifier(NSAppleEventDescriptor *window) {
+	return SPSPropertySpecifier(SPSSafariWindowMiniaturizedProperty, window);
+}
+
+
+/**
+ * Returns a specifier for the "URL" property of the given tab.
+ *
+ * The current URL of the tab.
+ */
+static inline NSAppleEventDescriptor *SPSSafariTabURLSpecifier(NSAppleEventDescriptor *tab) {
+	return SPSPropertySpecifier(SPSSafariTabURLProperty, tab);
+}
+
+
+/**
+ * Returns a specifier for the "URL" property of the given document.
+ *
+ * The current URL of the document.
+ */
+static inline NSAppleEventDescriptor *SPSSafariDocumentURLSpecifier(NSAppleEventDescriptor *document) {
+	return SPSPropertySpecifier(SPSSafariDocumentURLProperty, document);
+}
@@ -0,0 +1,193 @@
+//
+//  SPSSafariDriver.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import "SPSScriptingEngine.h"
+#import "SPSSpaceWindowIndex.h"
+
+
+@class SPSCircuitBreaker;
+
+
+#define SAFARI_BUNDLE_IDENTIFIER @"com.apple.Safari"
+#define SYSTEM_EVENTS_BUNDLE_IDENTIFIER @"com.apple.systemevents"
+
+
+/**
+ * The time after which a window that was asked for is no longer assumed to be on its way, in seconds.
+ */
+#define SPS_WINDOW_CREATION_GRACE_PERIOD 5.0
+
+/**
+ * The time within which an activation without URLs should be done, in seconds.
+ */
+#define SPS_ACTIVATION_BUDGET 5.0
+
+
+/**
+ * Whether a Safari window has been asked for that System Events may not report yet.
+ */
+typedef enum {
+	SPSWindowCreationStateIdle,
+	SPSWindowCreationStateInFlight
+} SPSWindowCreationState;
+
+
+/**
+ * Drives Safari and System Events through a scripting engine.
+ *
+ * A driver may only be used from the executor thread, which owns all of its scripting objects.
+ *
+ * Operations go through a circuit breaker. When Safari keeps timing out, URLs are only handed to Safari through NSWorkspace, without activating a window in the current space, until a probe gets an answer in time again.
+ *
+ * The driver remembers which window it left in front of Safari's windows, and how many tabs that window has. A link for that window then neither raises it nor counts its tabs, so that it only costs activating Safari and handing over the URL. Whoever sees Safari's windows change tells the driver with noteFrontWindow:, noteClosedWindow: or forgetFrontWindow. Tabs that the user opens or closes are not seen, so the tab indexes reported for such a window are counted from the tabs the driver opened.
+ */
+@interface SPSSafariDriver : NSObject <SPSScriptingEngineDelegate> {
+	id <SPSScriptingEngine> engine;
+	SPSCircuitBreaker *circuitBreaker;
+	NSError *lastError;
+	BOOL timedOut;
+	NSUInteger sentCommandCountAtStart;
+	NSInteger pooledWindowIdentifier;
+	pid_t lastProcessIdentifier;
+	SPSWindowCreationState windowCreationState;
+	pid_t windowCreationProcessIdentifier;
+	NSTimeInterval windowCreationTime;
+	NSUInteger appleEventCount;
+	volatile int32_t generation;
+	int32_t seenGeneration;
+	NSTimeInterval (^clock)(void);
+	pid_t (^safariProcessIdentifierLookup)(void);
+	NSInteger frontWindowIdentifier;
+	NSUInteger frontWindowTabCount;
+}
+
+/**
+ * Initializes the driver with a circuit breaker with the default threshold and cooldown.
+ *
+ * @param anEngine The scripting engine to send commands with, may not be nil. It is retained and its delegate is set to the driver.
+ */
+- (id)initWithEngine:(id <SPSScriptingEngine>)anEngine;
+
+/**
+ * Initializes the driver.
+ *
+ * @param anEngine The scripting engine to send commands with, may not be nil. It is retained and its delegate is set to the driver.
+ * @param aCircuitBreaker The circuit breaker that operations go through, may not be nil. Only an operation that sent a command records its outcome.
+ */
+- (id)initWithEngine:(id <SPSScriptingEngine>)anEngine circuitBreaker:(SPSCircuitBreaker *)aCircuitBreaker;
+
+/**
+ * A block that returns the current time, or nil to use +[NSDate timeIntervalSinceReferenceDate]. Deadlines, the circuit breaker and the grace period of window creation all go by this clock, so that the driver can be run in virtual time against an engine that keeps the same time.
+ */
+@property (copy) NSTimeInterval (^clock)(void);
+
+/**
+ * A block that returns the identifier of the running Safari process, or nil to ask NSRunningApplication. It is only called right after the driver has launched Safari.
+ */
+@property (copy) pid_t (^safariProcessIdentifierLookup)(void);
+
+/**
+ * Drops everything the driver remembers about Safari, for example because Safari has exited. Unlike the other methods, this may be called from any thread.
+ *
+ * The state is dropped before the next operation of the driver, so this takes effect without waiting for queued operations.
+ */
+- (void)invalidateState;
+
+/**
+ * Tells the driver that the given window has come to the front of Safari's windows, for example because it was made or clicked. Its tabs are counted again if it is not the window the driver left in front.
+ */
+- (void)noteFrontWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Tells the driver that the given window has been closed, after which the window in front is not known if it was that one.
+ */
+- (void)noteClosedWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Makes the driver forget which window is in front, for example because the active space changed. The next link raises its window and counts its tabs again.
+ */
+- (void)forgetFrontWindow;
+
+/**
+ * Opens the URLs of the given requests, recording the outcome in each request.
+ *
+ * @param requests An array of SPSURLRequest objects, may not be nil.
+ * @param processIdentifier The identifier of the running Safari process, or 0 if Safari is not running.
+ * @param windowIdentifier The Safari window in the current space to use, SPS_NO_WINDOW if there is none, or SPS_UNKNOWN_WINDOW to ask System Events.
+ * @param activate Whether to activate a window in the current space first. Pass NO if an activation that was queued before is still to complete.
+ *
+ * Apple Events are only given the time left until the earliest deadline of the requests. Requests that are cancelled before their URL has been handed to Safari get a userCanceledErr error.
+ *
+ * If the first request opens in a new window, a window is made for the batch whether or not it activates, and even while a window made for an earlier batch may still be coming up.
+ */
+- (void)dispatchRequests:(NSArray *)requests withProcessIdentifier:(pid_t)processIdentifier windowIdentifier:(NSInteger)windowIdentifier activatingWindow:(BOOL)activate;
+
+/**
+ * Activates a Safari window in the current space, creating a new one if necessary.
+ *
+ * Safari is launched if it is not running. A window is only created if none has been asked for already that Safari may still be bringing up, so that triggers arriving while Safari starts do not each create a window.
+ *
+ * @param processIdentifier The identifier of the running Safari process, or 0 if Safari is not running.
+ * @param windowIdentifier The Safari window in the current space to activate, SPS_NO_WINDOW if there is none, or SPS_UNKNOWN_WINDOW to ask System Events.
+ */
+- (void)activateWindowInCurrentSpaceWithProcessIdentifier:(pid_t)processIdentifier windowIdentifier:(NSInteger)windowIdentifier;
+
+/**
+ * Activates a Safari window in the current space, creating a new one that loads the given URL if necessary.
+ *
+ * Creating the window with its URL set takes a single command, instead of creating a blank window and opening the URL in a new tab next to it.
+ *
+ * @param processIdentifier The identifier of the running Safari process, or 0 if Safari is not running.
+ * @param windowIdentifier The Safari window in the current space to activate, SPS_NO_WINDOW if there is none, or SPS_UNKNOWN_WINDOW to ask System Events.
+ * @param URL The URL to load in a new window, or nil to create a blank window.
+ * @return Whether a new window was created with the given URL.
+ */
+- (BOOL)activateWindowInCurrentSpaceWithProcessIdentifier:(pid_t)processIdentifier windowIdentifier:(NSInteger)windowIdentifier initialURL:(NSURL *)URL;
+
+/**
+ * Makes a blank Safari window in the current space and miniaturizes it, so that it can be claimed for a link later.
+ *
+ * @param processIdentifier The identifier of the running Safari process.
+ * @param byteCount On return, how much the resident memory of Safari grew while making the window. May be NULL.
+ * @return The identifier of the new window, or 0 if it could not be made.
+ */
+- (NSInteger)makePooledWindowWithProcessIdentifier:(pid_t)processIdentifier byteCount:(int64_t *)byteCount;
+
+/**
+ * Makes the next activation restore the given pooled window and point it at the first URL, instead of making a new window.
+ */
+- (void)claimPooledWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Closes the given Safari window, for example because it was evicted from the pool.
+ */
+- (void)closeWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Opens the given URLs using Safari.
+ *
+ * @param URLs An array of URLs, may not be nil.
+ * @return Whether the URLs were handed to Safari.
+ */
+- (BOOL)openURLs:(NSArray *)URLs;
+
+@end
@@ -0,0 +1,523 @@
+//
+//  SPSSafariDriver.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSSafariDriver.h"
+#import "SPSURLRequest.h"
+#import "SPSCircuitBreaker.h"
+#import "SPSMetrics.h"
+#import "SPSTrace.h"
+#import "SPSTracingEngine.h"
+#import <libkern/OSAtomic.h>
+#import <libproc.h>
+
+
+/**
+ * Returns the resident memory size of the given process in bytes, or 0 if it is not known.
+ */
+static int64_t SPSResidentSizeOfProcess(pid_t processIdentifier) {
+	struct proc_taskinfo taskInfo;
+	
+	if (proc_pidinfo(processIdentifier, PROC_PIDTASKINFO, 0, &taskInfo, sizeof(taskInfo)) != sizeof(taskInfo)) {
+		return 0;
+	}
+	return (int64_t)taskInfo.pti_resident_size;
+}
+
+
+@interface SPSSafariDriver ()
+
+/**
+ * Drops the remembered state if it has been invalidated since the last operation.
+ */
+- (void)dropInvalidatedState;
+
+/**
+ * Returns the current time by the clock of the driver.
+ */
+- (NSTimeInterval)currentTime;
+
+/**
+ * Tells the circuit breaker whether Safari answered in time during the last operation, if any command was sent during it.
+ */
+- (void)recordOutcomeAtTime:(NSTimeInterval)time;
+
+/**
+ * Restores a pooled window, points it at the given URL and activates it.
+ *
+ * @return Whether the window could be used. If not, the errors along the way are forgotten so that a new window can be made instead.
+ */
+- (BOOL)restorePooledWindow:(NSInteger)windowIdentifier withURL:(NSURL *)URL;
+
+/**
+ * Makes a window in the current space and remembers that it is coming up.
+ *
+ * @param URL The URL the window should load, or nil for a blank window.
+ * @return Whether the window was made with the URL.
+ */
+- (BOOL)makeWindowWithProcessIdentifier:(pid_t)processIdentifier URL:(NSURL *)URL;
+
+@end
+
+
+@implementation SPSSafariDriver
+
+@synthesize clock;
+@synthesize safariProcessIdentifierLookup;
+
+- (id)initWithEngine:(id <SPSScriptingEngine>)anEngine {
+	SPSCircuitBreaker *defaultCircuitBreaker = [[SPSCircuitBreaker alloc] init];
+	self = [self initWithEngine:anEngine circuitBreaker:defaultCircuitBreaker];
+	[defaultCircuitBreaker release];
+	return self;
+}
+
+- (id)initWithEngine:(id <SPSScriptingEngine>)anEngine circuitBreaker:(SPSCircuitBreaker *)aCircuitBreaker {
+	if ((self = [super init])) {
+		engine = SPSTraceIsEnabled() ? [[SPSTracingEngine alloc] initWithEngine:anEngine] : [anEngine retain];
+		[engine setDelegate:self];
+		circuitBreaker = [aCircuitBreaker retain];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[engine setDelegate:nil];
+	[engine release];
+	[lastError release];
+	[circuitBreaker release];
+	[clock release];
+	[safariProcessIdentifierLookup release];
+	[super dealloc];
+}
+
+#pragma mark SPSScriptingEngineDelegate
+
+- (void)scriptingEngine:(id <SPSScriptingEngine>)anEngine didFailWithError:(NSError *)error {
+	if ([error code] == errAETimeout) {
+		timedOut = YES;
+	}
+	
+	// Remember the first error of the current dispatch, so that it can be reported to the sender
+	if (lastError == nil) {
+		lastError = [error retain];
+	}
+}
+
+#pragma mark SPSSafariDriver
+
+- (void)invalidateState {
+	OSAtomicIncrement32Barrier(&generation);
+}
+
+- (void)dropInvalidatedState {
+	int32_t currentGeneration = OSAtomicAdd32Barrier(0, &generation);
+	
+	if (currentGeneration != seenGeneration) {
+		windowCreationState = SPSWindowCreationStateIdle;
+		pooledWindowIdentifier = 0;
+		[self forgetFrontWindow];
+		[engine reset];
+		seenGeneration = currentGeneration;
+	}
+}
+
+- (void)noteFrontWindow:(NSInteger)windowIdentifier {
+	// The tabs of a window we did not leave in front have to be counted
+	if (windowIdentifier != frontWindowIdentifier) {
+		frontWindowIdentifier = windowIdentifier;
+		frontWindowTabCount = 0;
+	}
+}
+
+- (void)noteClosedWindow:(NSInteger)windowIdentifier {
+	if (windowIdentifier == frontWindowIdentifier) {
+		[self forgetFrontWindow];
+	}
+}
+
+- (void)forgetFrontWindow {
+	frontWindowIdentifier = 0;
+	frontWindowTabCount = 0;
+}
+
+- (NSTimeInterval)currentTime {
+	NSTimeInterval (^currentClock)(void) = [self clock];
+	return (currentClock != nil) ? currentClock() : [NSDate timeIntervalSinceReferenceDate];
+}
+
+- (void)recordOutcomeAtTime:(NSTimeInterval)time {
+	// Nothing was sent if every request had been cancelled or the deadline had passed, which says nothing about Safari
+	if ([engine sentCommandCount] == sentCommandCountAtStart) {
+		[circuitBreaker recordSkippedCallAtTime:time];
+	}
+	else if (timedOut) {
+		[circuitBreaker recordFailureAtTime:time];
+	}
+	else {
+		[circuitBreaker recordSuccessAtTime:time];
+	}
+}
+
+- (void)dispatchRequests:(NSArray *)requests withProcessIdentifier:(pid_t)processIdentifier windowIdentifier:(NSInteger)windowIdentifier activatingWindow:(BOOL)activate {
+	NSTimeInterval startTime = [self currentTime];
+	uint64_t traceBeginTime = SPSTraceBegin();
+	appleEventCount = 0;
+	
+	[self dropInvalidatedState];
+	
+	[lastError release];
+	lastError = nil;
+	
+	// Requests that were replaced before we got to them are not dispatched at all, and the others share the tightest deadline among them
+	NSMutableArray *liveRequests = [NSMutableArray arrayWithCapacity:[requests count]];
+	NSTimeInterval deadline = DBL_MAX;
+	for (SPSURLRequest *request in requests) {
+		if (![request isCancelled]) {
+			[liveRequests addObject:request];
+			deadline = MIN(deadline, [request deadline]);
+		}
+	}
+	[engine setDeadline:deadline];
+	
+	// While Safari does not answer scripting, the URLs are only handed to it, without looking for a window in the current space
+	BOOL degraded = ![circuitBreaker allowsCallAtTime:startTime];
+	if (degraded) {
+		SPSCounterAdd(SPSCounterDegradedBatches, 1);
+	}
+	timedOut = NO;
+	sentCommandCountAtStart = [engine sentCommandCount];
+	
+	NSMutableArray *openedRequests = [NSMutableArray arrayWithCapacity:[liveRequests count]];
+	NSArray *remainingRequests = liveRequests;
+	BOOL createdWindow = NO;
+	NSInteger tabCount = 1;
+	
+	SPSURLRequest *firstRequest = ([liveRequests count] > 0) ? [liveRequests objectAtIndex:0] : nil;
+	BOOL needsNewWindow = [firstRequest opensInNewWindow];
+	
+	// A batch that asks for a window of its own gets one, even while a window made for an earlier batch may still be coming up
+	if (needsNewWindow) {
+		windowCreationState = SPSWindowCreationStateIdle;
+	}
+	
+	// If there is no window in the current space, the new one is created with the first URL already loading
+	if (!degraded && firstRequest != nil && (activate || needsNewWindow)) {
+		if (activate) {
+			createdWindow = [self activateWindowInCurrentSpaceWithProcessIdentifier:processIdentifier windowIdentifier:windowIdentifier initialURL:[firstRequest URL]];
+		}
+		else {
+			// The activation this batch shares was handed to us before it, so Safari is already active and only the window is left to make
+			createdWindow = [self makeWindowWithProcessIdentifier:processIdentifier URL:[firstRequest URL]];
+		}
+		if (createdWindow) {
+			[openedRequests addObject:firstRequest];
+			remainingRequests = [liveRequests subarrayWithRange:NSMakeRange(1, [liveRequests count] - 1)];
+		}
+	}
+	
+	// Requests may have been replaced while Safari was being activated
+	remainingRequests = [remainingRequests filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"cancelled == NO"]];
+	
+	if (!degraded && ([remainingRequests count] > 0 || createdWindow)) {
+		// Any other URLs will be opened as new tabs at the end of the front window
+		if (windowIdentifier <= 0 || createdWindow) {
+			windowIdentifier = [engine frontWindowIdentifier];
+			appleEventCount++;
+		}
+		
+		// The tabs of the window we left in front were counted when we last opened URLs in it
+		if (!createdWindow && windowIdentifier == frontWindowIdentifier && frontWindowTabCount > 0) {
+			tabCount = frontWindowTabCount;
+		}
+		else if (!createdWindow) {
+			tabCount = [engine countOfTabsInWindow:windowIdentifier];
+			appleEventCount++;
+		}
+	}
+	
+	if ([remainingRequests count] > 0) {
+		// Handing the URLs to Safari cannot be given a timeout, so it is only done while there is time left
+		if ([self currentTime] >= deadline) {
+			SPSCounterAdd(SPSCounterOpenURLsDeadlineMisses, 1);
+			if (lastError == nil) {
+				lastError = [[NSError alloc] initWithDomain:NSOSStatusErrorDomain code:errAETimeout userInfo:nil];
+			}
+		}
+		else {
+			if (![self openURLs:[remainingRequests valueForKey:@"URL"]] && lastError == nil) {
+				lastError = [[NSError alloc] initWithDomain:NSOSStatusErrorDomain code:errAEEventFailed userInfo:[NSDictionary dictionaryWithObject:@"Safari could not open the URLs." forKey:NSLocalizedDescriptionKey]];
+			}
+			[openedRequests addObjectsFromArray:remainingRequests];
+			appleEventCount++;
+		}
+	}
+	
+	[engine setDeadline:0.0];
+	
+	// A claimed window that was not needed stays where it is
+	pooledWindowIdentifier = 0;
+	
+	if (!degraded) {
+		[self recordOutcomeAtTime:[self currentTime]];
+	}
+	
+	NSInteger tabIndex = createdWindow ? 0 : tabCount;
+	for (SPSURLRequest *request in requests) {
+		if (![openedRequests containsObject:request] && [request isCancelled]) {
+			SPSCounterAdd(SPSCounterCancelledRequests, 1);
+			[request setError:[NSError errorWithDomain:NSOSStatusErrorDomain code:userCanceledErr userInfo:nil]];
+		}
+		else if (lastError != nil) {
+			[request setError:lastError];
+		}
+		else if (!degraded) {
+			[request setWindowIdentifier:windowIdentifier];
+			[request setTabIndex:++tabIndex];
+		}
+	}
+	
+	// The URLs went to the end of the front window, unless we cannot tell where they went
+	if (lastError == nil && !degraded && windowIdentifier > 0) {
+		frontWindowIdentifier = windowIdentifier;
+		frontWindowTabCount = tabIndex;
+	}
+	else {
+		[self forgetFrontWindow];
+	}
+	
+	// Account for the cost per link of the path that was taken
+	int64_t microseconds = (int64_t)(([self currentTime] - startTime) * 1000000.0);
+	if (createdWindow) {
+		SPSCounterAdd(SPSCounterNewWindowPathLinks, [openedRequests count]);
+		SPSCounterAdd(SPSCounterNewWindowPathAppleEvents, appleEventCount);
+		SPSCounterAdd(SPSCounterNewWindowPathMicroseconds, microseconds);
+	}
+	else {
+		SPSCounterAdd(SPSCounterNewTabPathLinks, [openedRequests count]);
+		SPSCounterAdd(SPSCounterNewTabPathAppleEvents, appleEventCount);
+		SPSCounterAdd(SPSCounterNewTabPathMicroseconds, microseconds);
+	}
+	
+	SPSHistogramRecord(SPSHistogramDispatchMicroseconds, microseconds);
+	SPSTraceEnd(SPSTracePhaseDispatch, traceBeginTime);
+}
+
+- (void)activateWindowInCurrentSpaceWithProcessIdentifier:(pid_t)processIdentifier windowIdentifier:(NSInteger)windowIdentifier {
+	NSTimeInterval startTime = [self currentTime];
+	
+	// There is no degraded way to activate a window in the current space
+	if (![circuitBreaker allowsCallAtTime:startTime]) {
+		return;
+	}
+	timedOut = NO;
+	sentCommandCountAtStart = [engine sentCommandCount];
+	
+	[lastError release];
+	lastError = nil;
+	
+	uint64_t traceBeginTime = SPSTraceBegin();
+	[engine setDeadline:startTime + SPS_ACTIVATION_BUDGET];
+	[self activateWindowInCurrentSpaceWithProcessIdentifier:processIdentifier windowIdentifier:windowIdentifier initialURL:nil];
+	[engine setDeadline:0.0];
+	SPSTraceEnd(SPSTracePhaseActivation, traceBeginTime);
+	SPSHistogramRecord(SPSHistogramActivationMicroseconds, (int64_t)(([self currentTime] - startTime) * 1000000.0));
+	
+	[self recordOutcomeAtTime:[self currentTime]];
+}
+
+- (BOOL)activateWindowInCurrentSpaceWithProcessIdentifier:(pid_t)processIdentifier windowIdentifier:(NSInteger)windowIdentifier initialURL:(NSURL *)URL {
+	[self dropInvalidatedState];
+	
+	// A Safari that was launched behind our back needs a new connection
+	if (processIdentifier != 0 && processIdentifier != lastProcessIdentifier) {
+		[engine reset];
+		[self forgetFrontWindow];
+		lastProcessIdentifier = processIdentifier;
+	}
+	
+	// A window from the pool only has to be restored and pointed at the URL
+	if (pooledWindowIdentifier > 0) {
+		NSInteger windowFromPool = pooledWindowIdentifier;
+		pooledWindowIdentifier = 0;
+		
+		if ([self restorePooledWindow:windowFromPool withURL:URL]) {
+			windowCreationState = SPSWindowCreationStateIdle;
+			return (URL != nil);
+		}
+		windowIdentifier = SPS_UNKNOWN_WINDOW;
+	}
+	
+	// Bring the window we are after to the front of Safari's windows, so that activating Safari stays in this space, unless we left it there
+	if (windowIdentifier > 0 && windowIdentifier != frontWindowIdentifier) {
+		[engine raiseWindow:windowIdentifier];
+		appleEventCount++;
+		
+		if (lastError == nil) {
+			[self noteFrontWindow:windowIdentifier];
+		}
+		else {
+			[self forgetFrontWindow];
+		}
+	}
+	
+	// In any case, activate Safari, which launches it if it is not running
+	[engine activate];
+	appleEventCount++;
+	
+	// The caller cannot know the process identifier or windows of a Safari we just launched, so look them up
+	if (processIdentifier == 0) {
+		SPSCounterAdd(SPSCounterSafariLaunches, 1);
+		pid_t (^lookup)(void) = [self safariProcessIdentifierLookup];
+		processIdentifier = (lookup != nil) ? lookup() : [[[NSRunningApplication runningApplicationsWithBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER] lastObject] processIdentifier];
+		lastProcessIdentifier = processIdentifier;
+		windowIdentifier = SPS_UNKNOWN_WINDOW;
+		[self forgetFrontWindow];
+	}
+	
+	// Nothing to create if there already is a window in the current space
+	NSUInteger windowCount = (windowIdentifier > 0) ? 1 : 0;
+	if (windowIdentifier == SPS_UNKNOWN_WINDOW) {
+		windowCount = (processIdentifier != 0) ? [engine countOfWindowsOfProcessWithIdentifier:processIdentifier] : 0;
+		appleEventCount++;
+	}
+	if (windowCount > 0) {
+		windowCreationState = SPSWindowCreationStateIdle;
+		return NO;
+	}
+	
+	// Do not ask for another window while the one asked for before may still be coming up
+	NSTimeInterval now = [self currentTime];
+	if (windowCreationState == SPSWindowCreationStateInFlight && processIdentifier == windowCreationProcessIdentifier && now - windowCreationTime < SPS_WINDOW_CREATION_GRACE_PERIOD) {
+		SPSCounterAdd(SPSCounterJoinedWindowCreations, 1);
+		return NO;
+	}
+	
+	return [self makeWindowWithProcessIdentifier:processIdentifier URL:URL];
+}
+
+- (BOOL)restorePooledWindow:(NSInteger)windowIdentifier withURL:(NSURL *)URL {
+	[engine setMiniaturized:NO ofWindow:windowIdentifier];
+	appleEventCount++;
+	
+	if (lastError == nil && URL != nil) {
+		[engine setURL:URL ofTab:1 inWindow:windowIdentifier];
+		appleEventCount++;
+	}
+	
+	if (lastError == nil) {
+		[engine raiseWindow:windowIdentifier];
+		[engine activate];
+		appleEventCount += 2;
+	}
+	
+	if (lastError != nil) {
+		[lastError release];
+		lastError = nil;
+		[self forgetFrontWindow];
+		return NO;
+	}
+	
+	// A pooled window was made blank, so it has a single tab
+	frontWindowIdentifier = windowIdentifier;
+	frontWindowTabCount = 1;
+	return YES;
+}
+
+- (BOOL)makeWindowWithProcessIdentifier:(pid_t)processIdentifier URL:(NSURL *)URL {
+	// Make a window in the current space, pointed at the URL right away if there is one
+	[engine makeDocumentWithURL:URL];
+	appleEventCount++;
+	
+	// The new window is in front, but it is not known which one it is
+	[self forgetFrontWindow];
+	
+	SPSCounterAdd(SPSCounterWindowCreations, 1);
+	windowCreationState = SPSWindowCreationStateInFlight;
+	windowCreationProcessIdentifier = processIdentifier;
+	windowCreationTime = [self currentTime];
+	
+	return (URL != nil);
+}
+
+- (NSInteger)makePooledWindowWithProcessIdentifier:(pid_t)processIdentifier byteCount:(int64_t *)byteCount {
+	NSTimeInterval startTime = [self currentTime];
+	
+	[self dropInvalidatedState];
+	
+	// Making windows in advance is the first thing to give up on when Safari does not answer
+	if (![circuitBreaker allowsCallAtTime:startTime]) {
+		return 0;
+	}
+	timedOut = NO;
+	sentCommandCountAtStart = [engine sentCommandCount];
+	
+	[lastError release];
+	lastError = nil;
+	
+	int64_t residentSize = SPSResidentSizeOfProcess(processIdentifier);
+	[engine setDeadline:startTime + SPS_ACTIVATION_BUDGET];
+	
+	// The new window is Safari's front one, even though Safari is not active
+	NSInteger windowIdentifier = 0;
+	[engine makeDocumentWithURL:nil];
+	if (lastError == nil) {
+		windowIdentifier = [engine frontWindowIdentifier];
+	}
+	if (lastError == nil) {
+		[engine setMiniaturized:YES ofWindow:windowIdentifier];
+	}
+	
+	[engine setDeadline:0.0];
+	[self recordOutcomeAtTime:[self currentTime]];
+	
+	// Miniaturizing the window brings another one to the front, which may be in another space
+	[self forgetFrontWindow];
+	
+	// A window that could not be miniaturized is left as an ordinary window
+	if (lastError != nil) {
+		windowIdentifier = 0;
+	}
+	if (byteCount != NULL) {
+		*byteCount = MAX(SPSResidentSizeOfProcess(processIdentifier) - residentSize, 0);
+	}
+	
+	return windowIdentifier;
+}
+
+- (void)claimPooledWindow:(NSInteger)windowIdentifier {
+	pooledWindowIdentifier = windowIdentifier;
+}
+
+- (void)closeWindow:(NSInteger)windowIdentifier {
+	[self dropInvalidatedState];
+	
+	[engine setDeadline:[self currentTime] + SPS_ACTIVATION_BUDGET];
+	[engine closeWindow:windowIdentifier];
+	[engine setDeadline:0.0];
+	
+	[self noteClosedWindow:windowIdentifier];
+}
+
+- (BOOL)openURLs:(NSArray *)URLs {
+	return [engine openURLs:URLs];
+}
+
+@end
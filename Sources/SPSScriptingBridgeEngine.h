@@ -0,0 +1,46 @@
+//
+//  SPSScriptingBridgeEngine.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import <ScriptingBridge/ScriptingBridge.h>
+#import "SPSScriptingEngine.h"
+
+
+@class SPSConnectionCache;
+
+
+/**
+ * A scripting engine that uses ScriptingBridge.
+ *
+ * Only Safari is scripted through ScriptingBridge. The one question for System Events is sent as a raw Apple Event, so that its dictionary is never loaded.
+ */
+@interface SPSScriptingBridgeEngine : NSObject <SPSScriptingEngine, SBApplicationDelegate> {
+	id <SPSScriptingEngineDelegate> delegate;
+	SPSConnectionCache *connectionCache;
+	NSTimeInterval deadline;
+	NSTimeInterval commandStartTime;
+	OSStatus commandStatus;
+	NSAppleEventDescriptor *countProcessWindowsEvent;
+	pid_t countProcessWindowsProcessIdentifier;
+	NSUInteger sentCommandCount;
+}
+
+@end
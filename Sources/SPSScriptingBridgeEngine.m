@@ -0,0 +1,258 @@
+//
+//  SPSScriptingBridgeEngine.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSScriptingBridgeEngine.h"
+#import "SPSConnectionCache.h"
+#import "SPSSafariDriver.h"
+#import "SPSSafari.h"
+#import "SPSAppleEvents.h"
+#import "SPSSystemEventsCodes.h"
+#import "SPSMetrics.h"
+#import "SPSTrace.h"
+
+
+@interface SPSScriptingBridgeEngine ()
+
+/**
+ * Returns the current Safari application, starting Safari if necessary. Its commands time out at the deadline.
+ */
+- (SPSSafariApplication *)safariApplication;
+
+/**
+ * Returns the given Safari window.
+ */
+- (SPSSafariWindow *)windowWithIdentifier:(NSInteger)windowIdentifier;
+
+/**
+ * Starts a command.
+ *
+ * @param missCounter The counter of deadline misses for this kind of command.
+ * @return YES if the command should be sent, or NO if the deadline has already passed, in which case the command has failed.
+ */
+- (BOOL)beginCommandWithMissCounter:(SPSCounter)missCounter;
+
+/**
+ * Accounts for the command that was started last.
+ *
+ * @param missCounter The counter of deadline misses for this kind of command.
+ */
+- (void)endCommandWithMissCounter:(SPSCounter)missCounter;
+
+/**
+ * Reports a failed command to the delegate.
+ */
+- (void)failCommandWithStatus:(OSStatus)status;
+
+@end
+
+
+@implementation SPSScriptingBridgeEngine
+
+- (id)init {
+	if ((self = [super init])) {
+		connectionCache = [[SPSConnectionCache alloc] initWithDelegate:self];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[connectionCache release];
+	[countProcessWindowsEvent release];
+	[super dealloc];
+}
+
+#pragma mark SBApplicationDelegate
+
+- (id)eventDidFail:(const AppleEvent *)event withError:(NSError *)error {
+	commandStatus = (OSStatus)[error code];
+	[delegate scriptingEngine:self didFailWithError:error];
+	return nil;
+}
+
+#pragma mark SPSScriptingEngine
+
+- (void)setDelegate:(id <SPSScriptingEngineDelegate>)aDelegate {
+	delegate = aDelegate;
+}
+
+- (void)setDeadline:(NSTimeInterval)aDeadline {
+	deadline = aDeadline;
+}
+
+- (void)activate {
+	if ([self beginCommandWithMissCounter:SPSCounterActivateDeadlineMisses]) {
+		[[self safariApplication] activate];
+		[self endCommandWithMissCounter:SPSCounterActivateDeadlineMisses];
+	}
+}
+
+- (void)raiseWindow:(NSInteger)windowIdentifier {
+	if ([self beginCommandWithMissCounter:SPSCounterRaiseWindowDeadlineMisses]) {
+		[[self windowWithIdentifier:windowIdentifier] setIndex:1];
+		[self endCommandWithMissCounter:SPSCounterRaiseWindowDeadlineMisses];
+	}
+}
+
+- (void)setMiniaturized:(BOOL)miniaturized ofWindow:(NSInteger)windowIdentifier {
+	if ([self beginCommandWithMissCounter:SPSCounterMiniaturizeDeadlineMisses]) {
+		[[self windowWithIdentifier:windowIdentifier] setMiniaturized:miniaturized];
+		[self endCommandWithMissCounter:SPSCounterMiniaturizeDeadlineMisses];
+	}
+}
+
+- (void)closeWindow:(NSInteger)windowIdentifier {
+	if ([self beginCommandWithMissCounter:SPSCounterCloseWindowDeadlineMisses]) {
+		[[self windowWithIdentifier:windowIdentifier] closeSaving:SPSSafariSavoNo savingIn:nil];
+		[self endCommandWithMissCounter:SPSCounterCloseWindowDeadlineMisses];
+	}
+}
+
+- (NSInteger)frontWindowIdentifier {
+	NSInteger windowIdentifier = 0;
+	
+	if ([self beginCommandWithMissCounter:SPSCounterFrontWindowDeadlineMisses]) {
+		windowIdentifier = [[[[self safariApplication] windows] objectAtIndex:0] id];
+		[self endCommandWithMissCounter:SPSCounterFrontWindowDeadlineMisses];
+	}
+	
+	return windowIdentifier;
+}
+
+- (NSUInteger)countOfTabsInWindow:(NSInteger)windowIdentifier {
+	NSUInteger tabCount = 0;
+	
+	if ([self beginCommandWithMissCounter:SPSCounterCountTabsDeadlineMisses]) {
+		tabCount = [[[self windowWithIdentifier:windowIdentifier] tabs] count];
+		[self endCommandWithMissCounter:SPSCounterCountTabsDeadlineMisses];
+	}
+	
+	return tabCount;
+}
+
+- (void)makeDocumentWithURL:(NSURL *)URL {
+	if (![self beginCommandWithMissCounter:SPSCounterMakeDocumentDeadlineMisses]) {
+		return;
+	}
+	
+	SPSSafariApplication *safariApplication = [self safariApplication];
+	
+	NSDictionary *properties = (URL != nil) ? [NSDictionary dictionaryWithObject:[URL absoluteString] forKey:@"URL"] : [NSDictionary dictionary];
+	SPSSafariDocument *document = [[[safariApplication classForScriptingClass:@"document"] alloc] initWithProperties:properties];
+	[[safariApplication documents] addObject:document];
+	[document release];
+	
+	[self endCommandWithMissCounter:SPSCounterMakeDocumentDeadlineMisses];
+}
+
+- (void)setURL:(NSURL *)URL ofTab:(NSUInteger)tabIndex inWindow:(NSInteger)windowIdentifier {
+	if ([self beginCommandWithMissCounter:SPSCounterSetURLDeadlineMisses]) {
+		[(SPSSafariTab *)[[[self windowWithIdentifier:windowIdentifier] tabs] objectAtIndex:tabIndex - 1] setURL:[URL absoluteString]];
+		[self endCommandWithMissCounter:SPSCounterSetURLDeadlineMisses];
+	}
+}
+
+- (BOOL)openURLs:(NSArray *)URLs {
+	return [[NSWorkspace sharedWorkspace] openURLs:URLs withAppBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER options:NSWorkspaceLaunchDefault additionalEventParamDescriptor:nil launchIdentifiers:NULL];
+}
+
+- (NSUInteger)countOfWindowsOfProcessWithIdentifier:(pid_t)processIdentifier {
+	// The deadline is checked when sending the event
+	commandStartTime = [NSDate timeIntervalSinceReferenceDate];
+	
+	// System Events is only asked for this one count, so talk to it directly rather than have ScriptingBridge load its whole dictionary
+	if (countProcessWindowsEvent == nil) {
+		NSData *systemEventsBundleIdentifier = [SYSTEM_EVENTS_BUNDLE_IDENTIFIER dataUsingEncoding:NSUTF8StringEncoding];
+		NSAppleEventDescriptor *systemEventsTarget = [NSAppleEventDescriptor descriptorWithDescriptorType:typeApplicationBundleID data:systemEventsBundleIdentifier];
+		countProcessWindowsEvent = [[NSAppleEventDescriptor alloc] initWithEventClass:kAECoreSuite eventID:kAECountElements targetDescriptor:systemEventsTarget returnID:kAutoGenerateReturnID transactionID:kAnyTransactionID];
+		[countProcessWindowsEvent setParamDescriptor:[NSAppleEventDescriptor descriptorWithTypeCode:SPSSystemEventsWindowClass] forKeyword:keyAEObjectClass];
+	}
+	if (processIdentifier != countProcessWindowsProcessIdentifier) {
+		NSAppleEventDescriptor *process = SPSFirstElementSpecifier(SPSSystemEventsProcessClass, nil, SPSSystemEventsProcessUnixIdProperty, [NSAppleEventDescriptor descriptorWithInt32:processIdentifier]);
+		[countProcessWindowsEvent setParamDescriptor:process forKeyword:keyDirectObject];
+		countProcessWindowsProcessIdentifier = processIdentifier;
+	}
+	
+	if (SPSTimeoutForDeadline(deadline) != 0) {
+		sentCommandCount++;
+	}
+	
+	NSUInteger windowCount = [SPSSendAppleEvent(countProcessWindowsEvent, deadline, &commandStatus) int32Value];
+	if (commandStatus != noErr) {
+		[self failCommandWithStatus:commandStatus];
+	}
+	
+	[self endCommandWithMissCounter:SPSCounterCountWindowsDeadlineMisses];
+	return windowCount;
+}
+
+- (NSUInteger)sentCommandCount {
+	return sentCommandCount;
+}
+
+- (void)reset {
+	[connectionCache removeApplicationWithBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER];
+}
+
+#pragma mark SPSScriptingBridgeEngine
+
+- (SPSSafariApplication *)safariApplication {
+	uint64_t traceBeginTime = SPSTraceBegin();
+	SPSSafariApplication *safariApplication = [connectionCache applicationWithBundleIdentifier:SAFARI_BUNDLE_IDENTIFIER];
+	[safariApplication setTimeout:SPSTimeoutForDeadline(deadline)];
+	SPSTraceEnd(SPSTracePhaseConnection, traceBeginTime);
+	return safariApplication;
+}
+
+- (SPSSafariWindow *)windowWithIdentifier:(NSInteger)windowIdentifier {
+	return [[[self safariApplication] windows] objectWithID:[NSNumber numberWithInteger:windowIdentifier]];
+}
+
+- (BOOL)beginCommandWithMissCounter:(SPSCounter)missCounter {
+	commandStartTime = [NSDate timeIntervalSinceReferenceDate];
+	commandStatus = noErr;
+	
+	// Do not even start a command that cannot be answered in time
+	if (SPSTimeoutForDeadline(deadline) == 0) {
+		SPSCounterAdd(missCounter, 1);
+		[self failCommandWithStatus:errAETimeout];
+		return NO;
+	}
+	
+	sentCommandCount++;
+	return YES;
+}
+
+- (void)endCommandWithMissCounter:(SPSCounter)missCounter {
+	SPSCounterAdd(SPSCounterScriptingBridgeCommands, 1);
+	int64_t microseconds = (int64_t)(([NSDate timeIntervalSinceReferenceDate] - commandStartTime) * 1000000.0);
+	SPSCounterAdd(SPSCounterScriptingBridgeMicroseconds, microseconds);
+	SPSHistogramRecord(SPSHistogramAppleEventMicroseconds, microseconds);
+	
+	if (commandStatus == errAETimeout) {
+		SPSCounterAdd(missCounter, 1);
+	}
+}
+
+- (void)failCommandWithStatus:(OSStatus)status {
+	[delegate scriptingEngine:self didFailWithError:[NSError errorWithDomain:NSOSStatusErrorDomain code:status userInfo:nil]];
+}
+
+@end
@@ -0,0 +1,131 @@
+//
+//  SPSScriptingEngine.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+@protocol SPSScriptingEngine;
+
+
+/**
+ * Is told about commands of a scripting engine that failed.
+ */
+@protocol SPSScriptingEngineDelegate <NSObject>
+
+/**
+ * Called on the executor thread when a command has failed.
+ *
+ * @param error An error in NSOSStatusErrorDomain, with the Apple Event error number as its code.
+ */
+- (void)scriptingEngine:(id <SPSScriptingEngine>)engine didFailWithError:(NSError *)error;
+
+@end
+
+
+/**
+ * Sends the handful of commands that Spatial Safari needs to Safari and System Events.
+ *
+ * An engine may only be used from the executor thread. A failed command returns 0 and is reported to the delegate.
+ */
+@protocol SPSScriptingEngine <NSObject>
+
+/**
+ * The object that is told about failed commands. Not retained.
+ */
+- (void)setDelegate:(id <SPSScriptingEngineDelegate>)delegate;
+
+/**
+ * Sets the time by which commands have to be answered. Each command only waits for what is left until then, and once it has passed, commands fail with errAETimeout without being sent.
+ *
+ * @param deadline A time as returned by +[NSDate timeIntervalSinceReferenceDate], or 0 for no deadline.
+ */
+- (void)setDeadline:(NSTimeInterval)deadline;
+
+/**
+ * Activates Safari, launching it if it is not running.
+ */
+- (void)activate;
+
+/**
+ * Makes the given Safari window the front one.
+ */
+- (void)raiseWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Miniaturizes the given Safari window into the Dock, or restores it.
+ */
+- (void)setMiniaturized:(BOOL)miniaturized ofWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Closes the given Safari window.
+ */
+- (void)closeWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Returns the identifier of the front Safari window.
+ */
+- (NSInteger)frontWindowIdentifier;
+
+/**
+ * Returns the number of tabs in the given Safari window.
+ */
+- (NSUInteger)countOfTabsInWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Makes a new Safari document, and with it a window.
+ *
+ * @param URL The URL the document should load, or nil to make a blank document.
+ */
+- (void)makeDocumentWithURL:(NSURL *)URL;
+
+/**
+ * Points a tab of a Safari window at the given URL.
+ *
+ * @param URL A URL, may not be nil.
+ * @param tabIndex The one-based index of the tab.
+ * @param windowIdentifier The window that has the tab.
+ */
+- (void)setURL:(NSURL *)URL ofTab:(NSUInteger)tabIndex inWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Hands the given URLs to Safari through Launch Services, which opens them in new tabs of the front window. Unlike the other commands, this cannot be given a timeout.
+ *
+ * @param URLs An array of NSURL objects, may not be nil.
+ * @return Whether the URLs were handed to Safari.
+ */
+- (BOOL)openURLs:(NSArray *)URLs;
+
+/**
+ * Returns the number of windows of the given process in the current space, according to System Events.
+ */
+- (NSUInteger)countOfWindowsOfProcessWithIdentifier:(pid_t)processIdentifier;
+
+/**
+ * Returns the number of scripting commands that have been sent since the engine was made. Commands that failed without being sent, because the deadline had passed, are not counted, and neither are URLs handed over with openURLs:.
+ */
+- (NSUInteger)sentCommandCount;
+
+/**
+ * Drops any connection to Safari, for example because Safari has exited or launched.
+ */
+- (void)reset;
+
+@end
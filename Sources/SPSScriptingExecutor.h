@@ -0,0 +1,72 @@
+//
+//  SPSScriptingExecutor.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ * The number of blocks that can be waiting in an executor queue.
+ */
+#define SPS_SCRIPTING_EXECUTOR_CAPACITY 256
+
+
+/**
+ * Runs blocks one after another on a dedicated thread, so that slow Apple Events do not hold up the main run loop.
+ *
+ * Objects that send Apple Events, such as SBApplication instances, should only be used from blocks run by the executor. Blocks are handed over through a lock-free queue that supports a single producer, which is expected to be the main thread.
+ */
+@interface SPSScriptingExecutor : NSObject {
+	NSThread *thread;
+	dispatch_semaphore_t workSemaphore;
+	volatile int32_t invalidated;
+	void *slots[SPS_SCRIPTING_EXECUTOR_CAPACITY];
+	volatile uint32_t head;
+	volatile uint32_t tail;
+}
+
+/**
+ * Initializes the executor and starts its thread.
+ */
+- (id)init;
+
+/**
+ * Queues a block to be run on the executor thread. Must always be called from the same thread.
+ *
+ * The calling thread is never made to wait: when the queue is full, which only happens when the executor falls far behind, the block is turned away instead.
+ *
+ * @param block A block, may not be nil. It is copied if it is queued.
+ * @return Whether the block was queued. Not if the queue is full or the executor has been invalidated.
+ */
+- (BOOL)enqueueBlock:(void (^)(void))block;
+
+/**
+ * Stops the executor thread once the block it is running, if any, has returned. Blocks that are still queued are dropped without being run.
+ *
+ * The thread retains the executor, so the executor and everything its blocks hold on to are only released after this has been called. Must be called from the thread that queues blocks.
+ */
+- (void)invalidate;
+
+/**
+ * Whether the calling thread is the executor thread.
+ */
+- (BOOL)isExecutorThread;
+
+@end
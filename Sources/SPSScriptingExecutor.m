@@ -0,0 +1,130 @@
+//
+//  SPSScriptingExecutor.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSScriptingExecutor.h"
+#import <libkern/OSAtomic.h>
+#import <Block.h>
+#import "SPSMetrics.h"
+
+
+@interface SPSScriptingExecutor ()
+
+/**
+ * The body of the executor thread.
+ */
+- (void)run;
+
+/**
+ * Releases the blocks that are still queued, without running them. Only called on the executor thread.
+ */
+- (void)dropQueuedBlocks;
+
+@end
+
+
+@implementation SPSScriptingExecutor
+
+- (id)init {
+	if ((self = [super init])) {
+		workSemaphore = dispatch_semaphore_create(0);
+		
+		thread = [[NSThread alloc] initWithTarget:self selector:@selector(run) object:nil];
+		[thread setName:@"Spatial Safari scripting"];
+		[thread start];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	// The thread retains the executor, so this is only reached once the thread is gone
+	[thread release];
+	dispatch_release(workSemaphore);
+	[super dealloc];
+}
+
+- (BOOL)enqueueBlock:(void (^)(void))block {
+	if (invalidated) {
+		return NO;
+	}
+	
+	// Waiting for room would hold up the main run loop on a hung Safari, which is what the executor is there to prevent
+	if (tail - head == SPS_SCRIPTING_EXECUTOR_CAPACITY) {
+		SPSCounterAdd(SPSCounterExecutorRejections, 1);
+		return NO;
+	}
+	
+	slots[tail % SPS_SCRIPTING_EXECUTOR_CAPACITY] = (void *)Block_copy(block);
+	
+	// Publish the slot before the new tail
+	OSMemoryBarrier();
+	tail = tail + 1;
+	
+	dispatch_semaphore_signal(workSemaphore);
+	return YES;
+}
+
+- (void)invalidate {
+	if (OSAtomicCompareAndSwap32Barrier(0, 1, &invalidated)) {
+		// Wake the thread, so that it sees it has to stop
+		dispatch_semaphore_signal(workSemaphore);
+	}
+}
+
+- (BOOL)isExecutorThread {
+	return [NSThread currentThread] == thread;
+}
+
+- (void)run {
+	while (!invalidated) {
+		dispatch_semaphore_wait(workSemaphore, DISPATCH_TIME_FOREVER);
+		
+		while (head != tail && !invalidated) {
+			// Read the slot only after seeing the tail that published it
+			OSMemoryBarrier();
+			void (^block)(void) = (void (^)(void))slots[head % SPS_SCRIPTING_EXECUTOR_CAPACITY];
+			slots[head % SPS_SCRIPTING_EXECUTOR_CAPACITY] = NULL;
+			
+			OSMemoryBarrier();
+			head = head + 1;
+			
+			NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+			block();
+			Block_release(block);
+			[pool drain];
+		}
+	}
+	
+	[self dropQueuedBlocks];
+}
+
+- (void)dropQueuedBlocks {
+	// Blocks hold on to what they were going to use, which is only let go of here
+	while (head != tail) {
+		OSMemoryBarrier();
+		void (^block)(void) = (void (^)(void))slots[head % SPS_SCRIPTING_EXECUTOR_CAPACITY];
+		slots[head % SPS_SCRIPTING_EXECUTOR_CAPACITY] = NULL;
+		head = head + 1;
+		
+		Block_release(block);
+	}
+}
+
+@end
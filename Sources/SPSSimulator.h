@@ -0,0 +1,149 @@
+//
+//  SPSSimulator.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import "SPSDispatcher.h"
+
+
+@class SPSFakeSafari, SPSSpaceWindowIndex;
+
+
+/**
+ * The user defaults key of an array of policy configurations to simulate. Defaults to a sweep over coalescing windows and window pool sizes.
+ */
+#define SPS_SIMULATOR_CONFIGURATIONS_DEFAULT @"SimulatorConfigurations"
+
+/**
+ * The user defaults key of a dictionary that overrides the cost model, with the keys below.
+ */
+#define SPS_SIMULATOR_COSTS_DEFAULT @"SimulatorCosts"
+
+/**
+ * The keys of a policy configuration. Missing keys take the values the application uses.
+ */
+#define SPS_SIMULATOR_NAME_KEY @"Name"
+#define SPS_SIMULATOR_MINIMUM_WINDOW_KEY @"CoalescingMinimumWindow"
+#define SPS_SIMULATOR_MAXIMUM_WINDOW_KEY @"CoalescingMaximumWindow"
+#define SPS_SIMULATOR_MAXIMUM_LATENCY_KEY @"CoalescingMaximumLatency"
+#define SPS_SIMULATOR_POOL_CAPACITY_KEY @"WindowPoolCapacity"
+#define SPS_SIMULATOR_POOL_IDLE_TIMEOUT_KEY @"WindowPoolIdleTimeout"
+#define SPS_SIMULATOR_REQUEST_BUDGET_KEY @"RequestBudget"
+#define SPS_SIMULATOR_FAILURE_THRESHOLD_KEY @"FailureThreshold"
+#define SPS_SIMULATOR_COOLDOWN_KEY @"Cooldown"
+
+/**
+ * The keys of the cost model. Each cost is an array of its median in seconds and its spread, except for the probability that a command stalls.
+ */
+#define SPS_SIMULATOR_LAUNCH_COST_KEY @"Launch"
+#define SPS_SIMULATOR_WINDOW_CREATION_COST_KEY @"WindowCreation"
+#define SPS_SIMULATOR_ACTIVATION_COST_KEY @"Activation"
+#define SPS_SIMULATOR_ENUMERATION_COST_KEY @"Enumeration"
+#define SPS_SIMULATOR_COMMAND_COST_KEY @"Command"
+#define SPS_SIMULATOR_OPEN_URLS_COST_KEY @"OpenURLs"
+#define SPS_SIMULATOR_WINDOW_LIST_COST_KEY @"WindowList"
+#define SPS_SIMULATOR_STALL_PROBABILITY_KEY @"StallProbability"
+
+
+/**
+ * A log-normal distribution of durations.
+ */
+typedef struct {
+	NSTimeInterval median;
+	double spread;
+} SPSCostDistribution;
+
+/**
+ * What it costs Safari, System Events and the window server to do the things the controller asks of them.
+ */
+typedef struct {
+	SPSCostDistribution launch;
+	SPSCostDistribution windowCreation;
+	SPSCostDistribution activation;
+	SPSCostDistribution enumeration;
+	SPSCostDistribution command;
+	SPSCostDistribution openURLs;
+	SPSCostDistribution windowList;
+	double stallProbability;
+} SPSCostModel;
+
+
+/**
+ * Returns the cost model the simulator uses by default, with the given dictionary of overrides applied.
+ *
+ * @param overrides A dictionary with the cost model keys, or nil.
+ */
+SPSCostModel SPSCostModelWithOverrides(NSDictionary *overrides);
+
+
+/**
+ * Runs the policies of the controller against a model of Safari and System Events, in virtual time.
+ *
+ * The dispatcher, with the coalescer, window pool, space window index, circuit breaker and Safari driver it drives, is the one the application controller uses; the simulator only stands in for the rest of the controller, the clock, the main run loop and the executor thread, and the driver talks to a fake Safari that runs in virtual time. Every command the driver sends takes a duration drawn from the cost model, and a command that stalls takes until the deadline of its batch. Nothing is ever waited for, so hours of traffic are simulated in moments.
+ *
+ * Jobs wait in the executor's queue until the executor is done with the ones before them, and only then run against the fake Safari as it is by that time, so that a space switch or a quit while a job waits is seen by the job. What a job hands back reaches the dispatcher at the time the job is done.
+ *
+ * The random numbers are drawn from a fixed seed, so that the same events and configuration give the same results every time.
+ */
+@interface SPSSimulator : NSObject <SPSDispatcherDelegate> {
+	NSArray *events;
+	NSString *configurationName;
+	SPSCostModel costModel;
+	uint64_t randomState;
+	NSMutableArray *queue;
+	NSUInteger nextSequenceNumber;
+	NSTimeInterval now;
+	
+	SPSFakeSafari *fakeSafari;
+	SPSSpaceWindowIndex *spaceWindowIndex;
+	SPSDispatcher *dispatcher;
+	NSTimeInterval requestBudget;
+	
+	NSMutableArray *jobs;
+	BOOL executorBusy;
+	BOOL runningJob;
+	NSTimeInterval mainThreadCost;
+	
+	NSMutableArray *latencies;
+	NSUInteger failedURLCount;
+	NSUInteger batchCount;
+}
+
+/**
+ * Returns a sweep over coalescing windows and window pool sizes.
+ */
++ (NSArray *)defaultConfigurations;
+
+/**
+ * Initializes the simulator.
+ *
+ * @param someEvents Events as returned by the loaders of SPSReplayBenchmark.
+ * @param aCostModel The costs to draw from.
+ */
+- (id)initWithEvents:(NSArray *)someEvents costModel:(SPSCostModel)aCostModel;
+
+/**
+ * Simulates the events with each of the given configurations, and writes the distribution of the latency from event to dispatch for each to standard output.
+ *
+ * @param configurations An array of configuration dictionaries.
+ */
+- (void)runConfigurations:(NSArray *)configurations;
+
+@end
@@ -0,0 +1,527 @@
+//
+//  SPSSimulator.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSSimulator.h"
+#import "SPSReplayBenchmark.h"
+#import "SPSFakeSafari.h"
+#import "SPSSafariDriver.h"
+#import "SPSSpaceWindowIndex.h"
+#import "SPSCoalescer.h"
+#import "SPSWindowPool.h"
+#import "SPSCircuitBreaker.h"
+#import "SPSScriptingExecutor.h"
+#import "SPSApplicationController.h"
+#import "SPSURLRequest.h"
+#include <math.h>
+
+
+/**
+ * The seed of the random numbers of every run.
+ */
+#define SPS_SIMULATOR_SEED 0x5350535349ULL
+
+
+SPSCostModel SPSCostModelWithOverrides(NSDictionary *overrides) {
+	SPSCostModel model;
+	model.launch = (SPSCostDistribution){1.5, 0.4};
+	model.windowCreation = (SPSCostDistribution){0.15, 0.5};
+	model.activation = (SPSCostDistribution){0.05, 0.5};
+	model.enumeration = (SPSCostDistribution){0.08, 0.6};
+	model.command = (SPSCostDistribution){0.01, 0.5};
+	model.openURLs = (SPSCostDistribution){0.03, 0.5};
+	model.windowList = (SPSCostDistribution){0.001, 0.3};
+	model.stallProbability = 0.0;
+	
+	NSString *keys[] = {SPS_SIMULATOR_LAUNCH_COST_KEY, SPS_SIMULATOR_WINDOW_CREATION_COST_KEY, SPS_SIMULATOR_ACTIVATION_COST_KEY, SPS_SIMULATOR_ENUMERATION_COST_KEY, SPS_SIMULATOR_COMMAND_COST_KEY, SPS_SIMULATOR_OPEN_URLS_COST_KEY, SPS_SIMULATOR_WINDOW_LIST_COST_KEY};
+	SPSCostDistribution *distributions[] = {&model.launch, &model.windowCreation, &model.activation, &model.enumeration, &model.command, &model.openURLs, &model.windowList};
+	
+	for (NSUInteger index = 0; index < sizeof(keys) / sizeof(keys[0]); index++) {
+		NSArray *override = [overrides objectForKey:keys[index]];
+		if ([override isKindOfClass:[NSArray class]] && [override count] == 2) {
+			distributions[index]->median = [[override objectAtIndex:0] doubleValue];
+			distributions[index]->spread = [[override objectAtIndex:1] doubleValue];
+		}
+	}
+	if ([overrides objectForKey:SPS_SIMULATOR_STALL_PROBABILITY_KEY] != nil) {
+		model.stallProbability = [[overrides objectForKey:SPS_SIMULATOR_STALL_PROBABILITY_KEY] doubleValue];
+	}
+	
+	return model;
+}
+
+/**
+ * Returns the value below which the given fraction of the sorted values lies, by nearest rank.
+ */
+static NSTimeInterval SPSPercentile(NSArray *sortedValues, double fraction) {
+	NSUInteger count = [sortedValues count];
+	if (count == 0) {
+		return 0.0;
+	}
+	
+	NSUInteger index = (NSUInteger)ceil(fraction * count) - 1;
+	return [[sortedValues objectAtIndex:MIN(index, count - 1)] doubleValue];
+}
+
+
+/**
+ * Something that happens at a point in virtual time.
+ */
+@interface SPSSimulatorEvent : NSObject {
+	NSTimeInterval time;
+	NSUInteger sequenceNumber;
+	void (^action)(void);
+}
+
+- (id)initWithTime:(NSTimeInterval)aTime sequenceNumber:(NSUInteger)aSequenceNumber action:(void (^)(void))anAction;
+
+@property (readonly) NSTimeInterval time;
+@property (readonly) NSUInteger sequenceNumber;
+@property (readonly) void (^action)(void);
+
+@end
+
+
+@implementation SPSSimulatorEvent
+
+@synthesize time;
+@synthesize sequenceNumber;
+@synthesize action;
+
+- (id)initWithTime:(NSTimeInterval)aTime sequenceNumber:(NSUInteger)aSequenceNumber action:(void (^)(void))anAction {
+	if ((self = [super init])) {
+		time = aTime;
+		sequenceNumber = aSequenceNumber;
+		action = [anAction copy];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[action release];
+	[super dealloc];
+}
+
+@end
+
+
+@interface SPSSimulator ()
+
+/**
+ * Resets the fake Safari, the driver and the policies for a run with the given configuration.
+ */
+- (void)resetWithConfiguration:(NSDictionary *)configuration;
+
+/**
+ * Calls the given block at the given time. Events at the same time happen in the order in which they were scheduled.
+ */
+- (void)scheduleAtTime:(NSTimeInterval)time action:(void (^)(void))action;
+
+/**
+ * Schedules the event at the given index of the events, and the ones after it in turn.
+ */
+- (void)scheduleEventAtIndex:(NSUInteger)index;
+
+/**
+ * Returns the time on the main thread: the time of the event being handled, plus what handling it has cost so far.
+ */
+- (NSTimeInterval)mainThreadTime;
+
+/**
+ * Calls the given block on the main thread after the given delay. From a job, the delay counts from the time the job has got to.
+ */
+- (void)scheduleAfterDelay:(NSTimeInterval)delay action:(void (^)(void))action;
+
+/**
+ * Queues a job on the executor, which runs it once the main thread has handed it over and the jobs before it are done.
+ *
+ * @return Whether the job was queued. Not if SPS_SCRIPTING_EXECUTOR_CAPACITY jobs are already waiting, as with the scripting executor.
+ */
+- (BOOL)enqueueJob:(void (^)(void))job;
+
+/**
+ * Runs the job at the head of the executor's queue against the fake Safari, starting now, and has the executor take up the next one once it is done.
+ */
+- (void)runNextJob;
+
+/**
+ * Returns the time the fake Safari takes for the given command, drawn from the cost model, or INFINITY if the command stalls.
+ */
+- (NSTimeInterval)durationOfCommand:(SEL)command;
+
+/**
+ * Returns a duration drawn from the given distribution.
+ */
+- (NSTimeInterval)sample:(SPSCostDistribution)distribution;
+
+/**
+ * Returns a random number in (0, 1).
+ */
+- (double)uniform;
+
+@end
+
+
+@implementation SPSSimulator
+
++ (NSArray *)defaultConfigurations {
+	NSMutableArray *configurations = [NSMutableArray array];
+	NSTimeInterval maximumWindows[] = {0.01, 0.025, 0.05, 0.1};
+	NSUInteger poolCapacities[] = {0, SPS_WINDOW_POOL_CAPACITY};
+	
+	for (NSUInteger windowIndex = 0; windowIndex < sizeof(maximumWindows) / sizeof(maximumWindows[0]); windowIndex++) {
+		for (NSUInteger poolIndex = 0; poolIndex < sizeof(poolCapacities) / sizeof(poolCapacities[0]); poolIndex++) {
+			[configurations addObject:[NSDictionary dictionaryWithObjectsAndKeys:
+				[NSNumber numberWithDouble:maximumWindows[windowIndex]], SPS_SIMULATOR_MAXIMUM_WINDOW_KEY,
+				[NSNumber numberWithUnsignedInteger:poolCapacities[poolIndex]], SPS_SIMULATOR_POOL_CAPACITY_KEY,
+				nil]];
+		}
+	}
+	
+	return configurations;
+}
+
+- (id)initWithEvents:(NSArray *)someEvents costModel:(SPSCostModel)aCostModel {
+	if ((self = [super init])) {
+		events = [someEvents copy];
+		costModel = aCostModel;
+		queue = [[NSMutableArray alloc] init];
+		jobs = [[NSMutableArray alloc] init];
+		latencies = [[NSMutableArray alloc] init];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[events release];
+	[configurationName release];
+	[queue release];
+	[jobs release];
+	[dispatcher invalidate];
+	[dispatcher release];
+	[fakeSafari release];
+	[spaceWindowIndex release];
+	[latencies release];
+	[super dealloc];
+}
+
+- (void)runConfigurations:(NSArray *)configurations {
+	for (NSDictionary *configuration in configurations) {
+		NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+		
+		[self resetWithConfiguration:configuration];
+		[self scheduleEventAtIndex:0];
+		
+		while ([queue count] > 0) {
+			SPSSimulatorEvent *event = [[queue objectAtIndex:0] retain];
+			[queue removeObjectAtIndex:0];
+			
+			now = [event time];
+			mainThreadCost = 0.0;
+			[event action]();
+			[event release];
+		}
+		
+		[latencies sortUsingSelector:@selector(compare:)];
+		NSUInteger URLCount = [latencies count];
+		printf("configuration %s\n", [configurationName UTF8String]);
+		printf("urls %lu\n", (unsigned long)URLCount);
+		printf("failed_urls %lu\n", (unsigned long)failedURLCount);
+		printf("batches %lu\n", (unsigned long)batchCount);
+		printf("apple_events_per_url %.2f\n", (URLCount > 0) ? (double)[fakeSafari commandCount] / URLCount : 0.0);
+		
+		double fractions[] = {0.5, 0.9, 0.99, 0.999, 1.0};
+		const char *names[] = {"p50", "p90", "p99", "p999", "max"};
+		for (NSUInteger index = 0; index < sizeof(fractions) / sizeof(fractions[0]); index++) {
+			printf("%s_dispatch_microseconds %lld\n", names[index], (long long)(SPSPercentile(latencies, fractions[index]) * 1000000.0));
+		}
+		printf("\n");
+		
+		[pool release];
+	}
+	
+	fflush(stdout);
+}
+
+#pragma mark SPSDispatcherDelegate
+
+- (pid_t)safariProcessIdentifierForDispatcher:(SPSDispatcher *)aDispatcher {
+	return [fakeSafari processIdentifier];
+}
+
+- (NSInteger)dispatcher:(SPSDispatcher *)aDispatcher targetWindowIdentifierWithProcessIdentifier:(pid_t)processIdentifier {
+	if (processIdentifier == 0) {
+		return SPS_UNKNOWN_WINDOW;
+	}
+	
+	// Window changes are observed, so the window server is only asked when the index is out of date, which holds up the main thread
+	if ([spaceWindowIndex needsRefreshWithProcessIdentifier:processIdentifier atTime:now]) {
+		mainThreadCost += [self sample:costModel.windowList];
+		[spaceWindowIndex refreshWithProcessIdentifier:processIdentifier atTime:now];
+	}
+	
+	return [spaceWindowIndex targetWindowIdentifier];
+}
+
+- (void)dispatcher:(SPSDispatcher *)aDispatcher didDispatchRequests:(NSArray *)requests {
+	batchCount++;
+	
+	// Every request was made with the same budget, so its deadline tells when it arrived
+	for (SPSURLRequest *request in requests) {
+		[latencies addObject:[NSNumber numberWithDouble:now - ([request deadline] - requestBudget)]];
+		if ([request error] != nil) {
+			failedURLCount++;
+		}
+	}
+}
+
+#pragma mark SPSSimulator
+
+- (void)resetWithConfiguration:(NSDictionary *)configuration {
+	NSNumber *value;
+	NSTimeInterval minimumWindow = (value = [configuration objectForKey:SPS_SIMULATOR_MINIMUM_WINDOW_KEY]) ? [value doubleValue] : SPS_COALESCING_MINIMUM_WINDOW;
+	NSTimeInterval maximumWindow = (value = [configuration objectForKey:SPS_SIMULATOR_MAXIMUM_WINDOW_KEY]) ? [value doubleValue] : SPS_COALESCING_MAXIMUM_WINDOW;
+	NSTimeInterval maximumLatency = (value = [configuration objectForKey:SPS_SIMULATOR_MAXIMUM_LATENCY_KEY]) ? [value doubleValue] : SPS_COALESCING_MAXIMUM_LATENCY;
+	NSUInteger poolCapacity = (value = [configuration objectForKey:SPS_SIMULATOR_POOL_CAPACITY_KEY]) ? [value unsignedIntegerValue] : 0;
+	NSUInteger failureThreshold = (value = [configuration objectForKey:SPS_SIMULATOR_FAILURE_THRESHOLD_KEY]) ? [value unsignedIntegerValue] : SPS_CIRCUIT_BREAKER_FAILURE_THRESHOLD;
+	NSTimeInterval cooldown = (value = [configuration objectForKey:SPS_SIMULATOR_COOLDOWN_KEY]) ? [value doubleValue] : SPS_CIRCUIT_BREAKER_COOLDOWN;
+	NSTimeInterval poolIdleTimeout = (value = [configuration objectForKey:SPS_SIMULATOR_POOL_IDLE_TIMEOUT_KEY]) ? [value doubleValue] : SPS_WINDOW_POOL_IDLE_TIMEOUT;
+	requestBudget = (value = [configuration objectForKey:SPS_SIMULATOR_REQUEST_BUDGET_KEY]) ? [value doubleValue] : SPS_URL_REQUEST_BUDGET;
+	
+	// Unnamed configurations are named after all of their settings, defaults included
+	[configurationName release];
+	configurationName = [[configuration objectForKey:SPS_SIMULATOR_NAME_KEY] copy];
+	if (configurationName == nil) {
+		configurationName = [[NSString alloc] initWithFormat:@"window=%g-%g/%g pool=%lu budget=%g breaker=%lu/%g", minimumWindow, maximumWindow, maximumLatency, (unsigned long)poolCapacity, requestBudget, (unsigned long)failureThreshold, cooldown];
+	}
+	
+	// The fake, the driver and the dispatcher only refer back to the simulator, the fake and the dispatcher, which outlive them
+	__block SPSSimulator *simulator = self;
+	__block SPSFakeSafari *safari;
+	
+	[dispatcher invalidate];
+	[dispatcher release];
+	[fakeSafari release];
+	fakeSafari = safari = [[SPSFakeSafari alloc] initWithLatency:0.0 usesVirtualTime:YES];
+	[fakeSafari setLatencyHandler:^NSTimeInterval(SEL command) {
+		return [simulator durationOfCommand:command];
+	}];
+	
+	SPSCircuitBreaker *circuitBreaker = [[SPSCircuitBreaker alloc] initWithFailureThreshold:failureThreshold cooldown:cooldown];
+	SPSSafariDriver *safariDriver = [[SPSSafariDriver alloc] initWithEngine:fakeSafari circuitBreaker:circuitBreaker];
+	[safariDriver setClock:^NSTimeInterval {
+		return [safari currentTime];
+	}];
+	[safariDriver setSafariProcessIdentifierLookup:^pid_t {
+		return [safari processIdentifier];
+	}];
+	[circuitBreaker release];
+	
+	[spaceWindowIndex release];
+	spaceWindowIndex = [[SPSSpaceWindowIndex alloc] initWithSource:fakeSafari];
+	
+	SPSCoalescer *coalescer = [[SPSCoalescer alloc] initWithMinimumWindow:minimumWindow maximumWindow:maximumWindow maximumLatency:maximumLatency];
+	
+	// A pool without room is no pool
+	SPSWindowPool *windowPool = (poolCapacity > 0) ? [[SPSWindowPool alloc] initWithCapacity:poolCapacity idleTimeout:poolIdleTimeout] : nil;
+	
+	// The dispatcher is the controller's own, run in virtual time on the executor of the simulator
+	__block SPSDispatcher *runDispatcher;
+	dispatcher = runDispatcher = [[SPSDispatcher alloc] initWithSafariDriver:safariDriver spaceWindowIndex:spaceWindowIndex coalescer:coalescer windowPool:windowPool delegate:self];
+	[dispatcher setClock:^NSTimeInterval {
+		return [simulator mainThreadTime];
+	}];
+	[dispatcher setExecutor:^BOOL(void (^job)(void)) {
+		return [simulator enqueueJob:job];
+	}];
+	[dispatcher setScheduler:^(NSTimeInterval delay, void (^action)(void)) {
+		[simulator scheduleAfterDelay:delay action:action];
+	}];
+	[safariDriver release];
+	[coalescer release];
+	[windowPool release];
+	
+	// Tell the dispatcher about new windows, like the window observer would
+	[fakeSafari setWindowCreationHandler:^(NSInteger windowIdentifier) {
+		[simulator scheduleAtTime:[safari currentTime] action:^{
+			[runDispatcher windowWasCreated:windowIdentifier];
+		}];
+	}];
+	
+	randomState = SPS_SIMULATOR_SEED;
+	[queue removeAllObjects];
+	nextSequenceNumber = 0;
+	now = 0.0;
+	
+	[jobs removeAllObjects];
+	executorBusy = NO;
+	runningJob = NO;
+	mainThreadCost = 0.0;
+	
+	[latencies removeAllObjects];
+	failedURLCount = 0;
+	batchCount = 0;
+}
+
+- (void)scheduleAtTime:(NSTimeInterval)time action:(void (^)(void))action {
+	SPSSimulatorEvent *event = [[SPSSimulatorEvent alloc] initWithTime:time sequenceNumber:nextSequenceNumber++ action:action];
+	
+	// Keep the queue ordered by time, after any events at the same time
+	NSUInteger low = 0;
+	NSUInteger high = [queue count];
+	while (low < high) {
+		NSUInteger middle = (low + high) / 2;
+		if ([[queue objectAtIndex:middle] time] <= time) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+	
+	[queue insertObject:event atIndex:low];
+	[event release];
+}
+
+- (void)scheduleEventAtIndex:(NSUInteger)index {
+	if (index >= [events count]) {
+		return;
+	}
+	
+	NSDictionary *event = [events objectAtIndex:index];
+	[self scheduleAtTime:[[event objectForKey:SPS_EVENT_TIME_KEY] doubleValue] action:^{
+		NSString *kind = [event objectForKey:SPS_EVENT_KIND_KEY];
+		NSString *argument = [event objectForKey:SPS_EVENT_ARGUMENT_KEY];
+		
+		if ([kind isEqualToString:SPS_URL_EVENT]) {
+			SPSURLRequest *request = [[SPSURLRequest alloc] initWithURL:[NSURL URLWithString:argument] suspensionID:NULL deadline:now + requestBudget];
+			[dispatcher openRequest:request];
+			[request release];
+		}
+		else if ([kind isEqualToString:SPS_ACTIVATE_EVENT]) {
+			[dispatcher activateWindowInCurrentSpace];
+		}
+		else if ([kind isEqualToString:SPS_SPACE_EVENT]) {
+			[fakeSafari setActiveSpaceIdentifier:[argument integerValue]];
+			[dispatcher activeSpaceDidChange];
+		}
+		else if ([kind isEqualToString:SPS_STALL_EVENT] || [kind isEqualToString:SPS_RECOVER_EVENT]) {
+			[fakeSafari setStalled:[kind isEqualToString:SPS_STALL_EVENT]];
+		}
+		else if ([kind isEqualToString:SPS_QUIT_EVENT]) {
+			if ([fakeSafari processIdentifier] != 0) {
+				[fakeSafari quit];
+				[dispatcher safariDidExit];
+			}
+		}
+		
+		// Only the next event is queued at any time, so that the queue stays short however long the replay is
+		[self scheduleEventAtIndex:index + 1];
+	}];
+}
+
+- (NSTimeInterval)mainThreadTime {
+	return now + mainThreadCost;
+}
+
+- (void)scheduleAfterDelay:(NSTimeInterval)delay action:(void (^)(void))action {
+	NSTimeInterval startTime = runningJob ? [fakeSafari currentTime] : [self mainThreadTime];
+	[self scheduleAtTime:startTime + delay action:action];
+}
+
+- (BOOL)enqueueJob:(void (^)(void))job {
+	if ([jobs count] >= SPS_SCRIPTING_EXECUTOR_CAPACITY) {
+		return NO;
+	}
+	
+	// The job is handed over once the main thread is done with what it is doing, and waits there with its time of hand-over
+	SPSSimulatorEvent *entry = [[SPSSimulatorEvent alloc] initWithTime:[self mainThreadTime] sequenceNumber:nextSequenceNumber++ action:job];
+	[jobs addObject:entry];
+	[entry release];
+	
+	if (!executorBusy) {
+		executorBusy = YES;
+		[self scheduleAtTime:[self mainThreadTime] action:^{
+			[self runNextJob];
+		}];
+	}
+	return YES;
+}
+
+- (void)runNextJob {
+	SPSSimulatorEvent *entry = [[jobs objectAtIndex:0] retain];
+	[jobs removeObjectAtIndex:0];
+	
+	// The job sees Safari, its windows and the active space as they are by now, not as they were when it was queued
+	[fakeSafari setCurrentTime:now];
+	runningJob = YES;
+	[entry action]();
+	runningJob = NO;
+	[entry release];
+	
+	// The executor runs one job at a time, in the order in which they were handed to it
+	if ([jobs count] > 0) {
+		[self scheduleAtTime:MAX([fakeSafari currentTime], [[jobs objectAtIndex:0] time]) action:^{
+			[self runNextJob];
+		}];
+	}
+	else {
+		executorBusy = NO;
+	}
+}
+
+- (NSTimeInterval)durationOfCommand:(SEL)command {
+	// Launch Services takes the URLs without a reply from Safari, so handing them over never stalls
+	if (command == @selector(openURLs:)) {
+		return [self sample:costModel.openURLs];
+	}
+	if (costModel.stallProbability > 0.0 && [self uniform] < costModel.stallProbability) {
+		return INFINITY;
+	}
+	
+	if (command == @selector(activate)) {
+		return [self sample:([fakeSafari processIdentifier] == 0) ? costModel.launch : costModel.activation];
+	}
+	else if (command == @selector(makeDocumentWithURL:)) {
+		return [self sample:costModel.windowCreation];
+	}
+	else if (command == @selector(countOfWindowsOfProcessWithIdentifier:)) {
+		return [self sample:costModel.enumeration];
+	}
+	return [self sample:costModel.command];
+}
+
+- (NSTimeInterval)sample:(SPSCostDistribution)distribution {
+	// Box-Muller gives a standard normal number, which the median and spread turn into a log-normal duration
+	double normal = sqrt(-2.0 * log([self uniform])) * cos(2.0 * M_PI * [self uniform]);
+	return distribution.median * exp(distribution.spread * normal);
+}
+
+- (double)uniform {
+	// xorshift64*
+	randomState ^= randomState >> 12;
+	randomState ^= randomState << 25;
+	randomState ^= randomState >> 27;
+	uint64_t value = randomState * 0x2545F4914F6CDD1DULL;
+	
+	return ((value >> 11) + 0.5) / 9007199254740992.0;
+}
+
+@end
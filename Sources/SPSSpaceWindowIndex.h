@@ -0,0 +1,148 @@
+//
+//  SPSSpaceWindowIndex.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ * Window identifier meaning that there is no window.
+ */
+#define SPS_NO_WINDOW 0
+
+/**
+ * Window identifier meaning that it is not known whether there is a window.
+ */
+#define SPS_UNKNOWN_WINDOW -1
+
+/**
+ * The time after which the index no longer trusts incremental updates and queries the window list again, in seconds.
+ */
+#define SPS_SPACE_WINDOW_INDEX_MAXIMUM_AGE 30.0
+
+
+/**
+ * A source of on-screen windows, such as the window server or a synthetic window table.
+ */
+@protocol SPSWindowListSource <NSObject>
+
+/**
+ * Returns an identifier for the active space.
+ */
+- (NSInteger)activeSpaceIdentifier;
+
+/**
+ * Returns the identifiers of the on-screen windows of the given process, ordered front to back.
+ *
+ * Only windows in the active space are on screen, so these are the windows of the process in that space.
+ *
+ * @param processIdentifier A process identifier.
+ * @return An array of NSNumber objects.
+ */
+- (NSArray *)onScreenWindowIdentifiersOfProcessWithIdentifier:(pid_t)processIdentifier;
+
+@end
+
+
+/**
+ * Keeps track of the windows of one process in every space, and of the window that was used most recently in each space.
+ *
+ * Window identifiers are window server window numbers, which Cocoa scripting also uses as the ids of windows.
+ */
+@interface SPSSpaceWindowIndex : NSObject {
+	id <SPSWindowListSource> source;
+	pid_t processIdentifier;
+	NSInteger activeSpaceIdentifier;
+	NSMutableDictionary *windowIdentifiersBySpaceIdentifier;
+	NSMutableDictionary *recentWindowIdentifiersBySpaceIdentifier;
+	NSTimeInterval refreshTime;
+	BOOL valid;
+}
+
+/**
+ * Initializes the index.
+ *
+ * @param aSource A window list source, may not be nil.
+ */
+- (id)initWithSource:(id <SPSWindowListSource>)aSource;
+
+/**
+ * Queries the window list once and updates the windows of the active space.
+ *
+ * @param aProcessIdentifier The process whose windows to index, or 0 if it is not running. Changing the process forgets all windows.
+ * @param time The current time.
+ */
+- (void)refreshWithProcessIdentifier:(pid_t)aProcessIdentifier atTime:(NSTimeInterval)time;
+
+/**
+ * Whether the index should be refreshed before it is used: because it was invalidated, is about another process, or has not been refreshed for a while.
+ *
+ * @param aProcessIdentifier The process whose windows are to be used.
+ * @param time The current time.
+ */
+- (BOOL)needsRefreshWithProcessIdentifier:(pid_t)aProcessIdentifier atTime:(NSTimeInterval)time;
+
+/**
+ * Makes the next use of the index refresh it, for example because window changes may have been missed.
+ */
+- (void)invalidate;
+
+/**
+ * Records a window that has been created in the active space.
+ */
+- (void)addWindowIdentifier:(NSInteger)windowIdentifier;
+
+/**
+ * Records a window that has been closed, in whatever space it was.
+ */
+- (void)removeWindowIdentifier:(NSInteger)windowIdentifier;
+
+/**
+ * Returns the identifier of the active space, as of the last refresh.
+ */
+- (NSInteger)activeSpaceIdentifier;
+
+/**
+ * Returns the identifiers of the windows in the active space, as of the last refresh, ordered front to back.
+ */
+- (NSArray *)windowIdentifiersInActiveSpace;
+
+/**
+ * Returns the window in the active space that URLs should go to: the one used most recently if it is still there, or else the frontmost one.
+ *
+ * @return A window identifier, or SPS_NO_WINDOW if there is no window in the active space.
+ */
+- (NSInteger)targetWindowIdentifier;
+
+/**
+ * Records that a window in the active space has been used.
+ */
+- (void)noteWindowUsed:(NSInteger)windowIdentifier;
+
+@end
+
+
+/**
+ * A window list source that queries the window server.
+ */
+@interface SPSWindowServerWindowListSource : NSObject <SPSWindowListSource> {
+}
+
+@end
@@ -0,0 +1,167 @@
+//
+//  SPSSpaceWindowIndex.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSSpaceWindowIndex.h"
+
+
+/*
+ * Private window server functions for finding out the active space, which has no public API.
+ */
+typedef int CGSConnection;
+extern CGSConnection _CGSDefaultConnection(void);
+extern CGError CGSGetWorkspace(CGSConnection connection, int *workspace);
+
+
+@implementation SPSSpaceWindowIndex
+
+- (id)initWithSource:(id <SPSWindowListSource>)aSource {
+	if ((self = [super init])) {
+		source = [aSource retain];
+		windowIdentifiersBySpaceIdentifier = [[NSMutableDictionary alloc] init];
+		recentWindowIdentifiersBySpaceIdentifier = [[NSMutableDictionary alloc] init];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[source release];
+	[windowIdentifiersBySpaceIdentifier release];
+	[recentWindowIdentifiersBySpaceIdentifier release];
+	[super dealloc];
+}
+
+- (void)refreshWithProcessIdentifier:(pid_t)aProcessIdentifier atTime:(NSTimeInterval)time {
+	// Windows of another process mean nothing to us
+	if (aProcessIdentifier != processIdentifier) {
+		[windowIdentifiersBySpaceIdentifier removeAllObjects];
+		[recentWindowIdentifiersBySpaceIdentifier removeAllObjects];
+		processIdentifier = aProcessIdentifier;
+	}
+	
+	activeSpaceIdentifier = [source activeSpaceIdentifier];
+	NSNumber *spaceKey = [NSNumber numberWithInteger:activeSpaceIdentifier];
+	NSArray *windowIdentifiers = (processIdentifier != 0) ? [source onScreenWindowIdentifiersOfProcessWithIdentifier:processIdentifier] : [NSArray array];
+	
+	// A window is in one space at a time, so forget about any window that has moved here from another space
+	for (NSNumber *otherSpaceKey in [windowIdentifiersBySpaceIdentifier allKeys]) {
+		if (![otherSpaceKey isEqualToNumber:spaceKey]) {
+			NSMutableArray *otherWindowIdentifiers = [windowIdentifiersBySpaceIdentifier objectForKey:otherSpaceKey];
+			[otherWindowIdentifiers removeObjectsInArray:windowIdentifiers];
+		}
+	}
+	
+	[windowIdentifiersBySpaceIdentifier setObject:[NSMutableArray arrayWithArray:windowIdentifiers] forKey:spaceKey];
+	
+	refreshTime = time;
+	valid = YES;
+}
+
+- (BOOL)needsRefreshWithProcessIdentifier:(pid_t)aProcessIdentifier atTime:(NSTimeInterval)time {
+	return !valid || aProcessIdentifier != processIdentifier || time - refreshTime >= SPS_SPACE_WINDOW_INDEX_MAXIMUM_AGE;
+}
+
+- (void)invalidate {
+	valid = NO;
+}
+
+- (void)addWindowIdentifier:(NSInteger)windowIdentifier {
+	NSNumber *windowKey = [NSNumber numberWithInteger:windowIdentifier];
+	NSNumber *spaceKey = [NSNumber numberWithInteger:activeSpaceIdentifier];
+	
+	[self removeWindowIdentifier:windowIdentifier];
+	
+	// New windows open in the active space, in front of the others
+	NSMutableArray *windowIdentifiers = [windowIdentifiersBySpaceIdentifier objectForKey:spaceKey];
+	if (windowIdentifiers == nil) {
+		windowIdentifiers = [NSMutableArray array];
+		[windowIdentifiersBySpaceIdentifier setObject:windowIdentifiers forKey:spaceKey];
+	}
+	[windowIdentifiers insertObject:windowKey atIndex:0];
+}
+
+- (void)removeWindowIdentifier:(NSInteger)windowIdentifier {
+	NSNumber *windowKey = [NSNumber numberWithInteger:windowIdentifier];
+	
+	for (NSMutableArray *windowIdentifiers in [windowIdentifiersBySpaceIdentifier allValues]) {
+		[windowIdentifiers removeObject:windowKey];
+	}
+}
+
+- (NSInteger)activeSpaceIdentifier {
+	return activeSpaceIdentifier;
+}
+
+- (NSArray *)windowIdentifiersInActiveSpace {
+	NSArray *windowIdentifiers = [windowIdentifiersBySpaceIdentifier objectForKey:[NSNumber numberWithInteger:activeSpaceIdentifier]];
+	return (windowIdentifiers != nil) ? windowIdentifiers : [NSArray array];
+}
+
+- (NSInteger)targetWindowIdentifier {
+	NSArray *windowIdentifiers = [self windowIdentifiersInActiveSpace];
+	NSNumber *recentWindowIdentifier = [recentWindowIdentifiersBySpaceIdentifier objectForKey:[NSNumber numberWithInteger:activeSpaceIdentifier]];
+	
+	if (recentWindowIdentifier != nil && [windowIdentifiers containsObject:recentWindowIdentifier]) {
+		return [recentWindowIdentifier integerValue];
+	}
+	else if ([windowIdentifiers count] > 0) {
+		return [[windowIdentifiers objectAtIndex:0] integerValue];
+	}
+	else {
+		return SPS_NO_WINDOW;
+	}
+}
+
+- (void)noteWindowUsed:(NSInteger)windowIdentifier {
+	[recentWindowIdentifiersBySpaceIdentifier setObject:[NSNumber numberWithInteger:windowIdentifier] forKey:[NSNumber numberWithInteger:activeSpaceIdentifier]];
+}
+
+@end
+
+
+@implementation SPSWindowServerWindowListSource
+
+- (NSInteger)activeSpaceIdentifier {
+	int workspace = 0;
+	CGSGetWorkspace(_CGSDefaultConnection(), &workspace);
+	return workspace;
+}
+
+- (NSArray *)onScreenWindowIdentifiersOfProcessWithIdentifier:(pid_t)processIdentifier {
+	NSMutableArray *windowIdentifiers = [NSMutableArray array];
+	
+	// The window list is ordered front to back, and only has windows in the active space
+	CFArrayRef windowList = CGWindowListCopyWindowInfo(kCGWindowListOptionOnScreenOnly | kCGWindowListExcludeDesktopElements, kCGNullWindowID);
+	if (windowList == NULL) {
+		return windowIdentifiers;
+	}
+	
+	for (NSDictionary *windowInfo in (NSArray *)windowList) {
+		// Only count normal windows, not menus, sheets and the like
+		if ([[windowInfo objectForKey:(id)kCGWindowOwnerPID] intValue] == processIdentifier && [[windowInfo objectForKey:(id)kCGWindowLayer] intValue] == 0) {
+			[windowIdentifiers addObject:[windowInfo objectForKey:(id)kCGWindowNumber]];
+		}
+	}
+	CFRelease(windowList);
+	
+	return windowIdentifiers;
+}
+
+@end
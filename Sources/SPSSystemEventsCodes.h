@@ -0,0 +1,26 @@
+/*
+ * SPSSystemEventsCodes.h
+ *
+ * Generated by Tools/sdefstubs.py for: application.processes, process.windows, process.unix id
+ * Do not edit; run the generator again instead.
+ */
+
+#import "SPSAppleEvents.h"
+
+
+enum {
+	SPSSystemEventsApplicationClass = 'capp',
+	SPSSystemEventsProcessClass = 'prcs',
+	SPSSystemEventsWindowClass = 'cwin',
+	SPSSystemEventsProcessUnixIdProperty = 'idux',
+};
+
+
+/**
+ * Returns a specifier for the "unix id" property of the given process.
+ *
+ * The Unix process identifier of a process running in the native environment, or -1 for a process running in the Classic environment.
+ */
+static inline NSAppleEventDescriptor *SPSSystemEventsProcessUnixIdSpecifier(NSAppleEventDescriptor *process) {
+	return SPSPropertySpecifier(SPSSystemEventsProcessUnixIdProperty, process);
+}
@@ -0,0 +1,191 @@
+//
+//  SPSToolMain.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Cocoa/Cocoa.h>
+#import "SPSApplicationController.h"
+#import "SPSReplayBenchmark.h"
+#import "SPSAppleEventBudget.h"
+#import "SPSBulkImporter.h"
+#import "SPSURLFileReader.h"
+#import "SPSSimulator.h"
+#import "SPSEngineBenchmark.h"
+#import "SPSTrace.h"
+
+
+/**
+ * Writes how the tool is used to standard error.
+ *
+ * @return The exit status of a tool that was used wrongly.
+ */
+static int SPSToolUsage(void) {
+	fprintf(stderr, "usage: sps-tool replay <replay file | event log | synthetic>\n");
+	fprintf(stderr, "       sps-tool simulate <replay file | event log | synthetic>\n");
+	fprintf(stderr, "       sps-tool budgets <property list | builtin>\n");
+	fprintf(stderr, "       sps-tool import <file of URLs>\n");
+	fprintf(stderr, "       sps-tool engines <rounds>\n");
+	return 2;
+}
+
+/**
+ * Runs the policies of the controller against the given events, in virtual time, so that it does not even need a run loop.
+ */
+static int SPSToolSimulate(NSString *replay) {
+	NSArray *events = [SPSReplayBenchmark eventsWithContentsOfReplay:replay speed:1.0];
+	if (events == nil) {
+		fprintf(stderr, "Could not read replay %s\n", [replay fileSystemRepresentation]);
+		return 1;
+	}
+	
+	NSArray *configurations = [[NSUserDefaults standardUserDefaults] arrayForKey:SPS_SIMULATOR_CONFIGURATIONS_DEFAULT];
+	SPSCostModel costModel = SPSCostModelWithOverrides([[NSUserDefaults standardUserDefaults] dictionaryForKey:SPS_SIMULATOR_COSTS_DEFAULT]);
+	
+	SPSSimulator *simulator = [[SPSSimulator alloc] initWithEvents:events costModel:costModel];
+	[simulator runConfigurations:(configurations != nil) ? configurations : [SPSSimulator defaultConfigurations]];
+	[simulator release];
+	
+	return 0;
+}
+
+/**
+ * Checks the given budgets against a fake Safari, one scenario after another. Does not return if the budgets could be read, but exits with the result.
+ */
+static int SPSToolCheckBudgets(NSString *budgets) {
+	NSArray *scenarios = [budgets isEqualToString:SPS_BUILTIN_BUDGETS] ? [SPSAppleEventBudget builtinScenarios] : [SPSAppleEventBudget scenariosWithContentsOfFile:budgets];
+	if (scenarios == nil) {
+		fprintf(stderr, "Could not read budgets %s\n", [budgets fileSystemRepresentation]);
+		return 1;
+	}
+	
+	SPSAppleEventBudget *budget = [[SPSAppleEventBudget alloc] initWithScenarios:scenarios];
+	[budget start];
+	
+	[NSApp run];
+	
+	[budget release];
+	return 0;
+}
+
+/**
+ * Replays the given events against a controller of its own and a fake Safari. Does not return if the events could be read.
+ */
+static int SPSToolReplay(NSString *replay) {
+	double speed = [[NSUserDefaults standardUserDefaults] doubleForKey:SPS_REPLAY_SPEED_DEFAULT];
+	NSArray *events = [SPSReplayBenchmark eventsWithContentsOfReplay:replay speed:(speed > 0.0) ? speed : 1.0];
+	if (events == nil) {
+		fprintf(stderr, "Could not read replay %s\n", [replay fileSystemRepresentation]);
+		return 1;
+	}
+	
+	NSTimeInterval latency = [[NSUserDefaults standardUserDefaults] doubleForKey:SPS_REPLAY_LATENCY_DEFAULT] / 1000.0;
+	SPSControllerSettings settings = SPSDefaultControllerSettings();
+	settings.usesWindowPool = [[NSUserDefaults standardUserDefaults] boolForKey:SPS_REPLAY_WINDOW_POOL_DEFAULT];
+	
+	SPSReplayBenchmark *benchmark = [[SPSReplayBenchmark alloc] initWithEvents:events latency:latency settings:settings];
+	[benchmark start];
+	
+	[NSApp run];
+	
+	[benchmark release];
+	return 0;
+}
+
+/**
+ * Opens the URLs in the given file in Safari, driving it like the agent does, and quits when done. Does not return if the file could be read.
+ */
+static int SPSToolImport(NSString *importPath) {
+	SPSURLFileReader *reader = [[SPSURLFileReader alloc] initWithPath:[importPath stringByExpandingTildeInPath]];
+	if (reader == nil) {
+		fprintf(stderr, "Could not read URLs from %s\n", [importPath fileSystemRepresentation]);
+		return 1;
+	}
+	
+	NSInteger loadingTabCount = [[NSUserDefaults standardUserDefaults] integerForKey:SPS_BULK_IMPORT_LOADING_TABS_DEFAULT];
+	NSInteger tabsPerWindow = [[NSUserDefaults standardUserDefaults] integerForKey:SPS_BULK_IMPORT_TABS_PER_WINDOW_DEFAULT];
+	SPSApplicationController *controller = [[SPSApplicationController alloc] initWithSettings:SPSDefaultControllerSettings()];
+	SPSBulkImporter *importer = [[SPSBulkImporter alloc] initWithReader:reader controller:controller maximumLoadingTabCount:(loadingTabCount > 0) ? loadingTabCount : SPS_BULK_IMPORT_LOADING_TABS tabsPerWindow:(tabsPerWindow > 0) ? tabsPerWindow : SPS_BULK_IMPORT_TABS_PER_WINDOW];
+	[reader release];
+	[controller release];
+	[importer start];
+	
+	[NSApp run];
+	
+	[importer release];
+	return 0;
+}
+
+/**
+ * Compares the latency of the scripting engines against the real Safari.
+ */
+static int SPSToolCompareEngines(NSString *rounds) {
+	NSInteger roundCount = [rounds integerValue];
+	
+	SPSEngineBenchmark *benchmark = [[SPSEngineBenchmark alloc] initWithRounds:(roundCount > 0) ? roundCount : SPS_ENGINE_BENCHMARK_ROUNDS];
+	BOOL succeeded = [benchmark run];
+	[benchmark release];
+	
+	return succeeded ? 0 : 1;
+}
+
+/**
+ * The entry point of the tool that runs the benchmarks, the simulator, the budget check, the comparison of the scripting engines and bulk imports, so that the application itself only carries the agent.
+ *
+ * The first argument names what to run and the second what to run it on. Further options are given as user defaults on the command line, such as -ReplayLatency 20.
+ */
+int main(int argc, const char *argv[]) {
+	if (argc < 3) {
+		return SPSToolUsage();
+	}
+	
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+	[NSApplication sharedApplication];
+	
+	// Tracing has to be on before the driver is made, which only puts its tracing engine in place then
+	NSString *tracePath = [[NSUserDefaults standardUserDefaults] stringForKey:SPS_TRACE_FILE_DEFAULT];
+	if (tracePath != nil) {
+		SPSTraceStart([tracePath stringByExpandingTildeInPath]);
+	}
+	
+	NSString *command = [NSString stringWithUTF8String:argv[1]];
+	NSString *argument = [NSString stringWithUTF8String:argv[2]];
+	
+	int status;
+	if ([command isEqualToString:@"replay"]) {
+		status = SPSToolReplay(argument);
+	}
+	else if ([command isEqualToString:@"simulate"]) {
+		status = SPSToolSimulate(argument);
+	}
+	else if ([command isEqualToString:@"budgets"]) {
+		status = SPSToolCheckBudgets(argument);
+	}
+	else if ([command isEqualToString:@"import"]) {
+		status = SPSToolImport(argument);
+	}
+	else if ([command isEqualToString:@"engines"]) {
+		status = SPSToolCompareEngines(argument);
+	}
+	else {
+		status = SPSToolUsage();
+	}
+	
+	[pool release];
+	return status;
+}
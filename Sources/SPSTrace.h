@@ -0,0 +1,89 @@
+//
+//  SPSTrace.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ * The user defaults key of the file to write traces to. Tracing is only enabled if it is set.
+ */
+#define SPS_TRACE_FILE_DEFAULT @"TraceFile"
+
+/**
+ * The number of spans each thread keeps. Older spans are overwritten.
+ */
+#define SPS_TRACE_BUFFER_CAPACITY 4096
+
+
+/**
+ * The phases of handling a link that are traced.
+ */
+typedef enum {
+	SPSTracePhaseParseURL,
+	SPSTracePhaseTargetWindow,
+	SPSTracePhaseDispatch,
+	SPSTracePhaseActivation,
+	SPSTracePhaseConnection,
+	SPSTracePhaseActivate,
+	SPSTracePhaseRaiseWindow,
+	SPSTracePhaseMiniaturize,
+	SPSTracePhaseCloseWindow,
+	SPSTracePhaseFrontWindow,
+	SPSTracePhaseCountTabs,
+	SPSTracePhaseMakeDocument,
+	SPSTracePhaseSetURL,
+	SPSTracePhaseOpenURLs,
+	SPSTracePhaseCountWindows,
+	SPSTracePhaseCount
+} SPSTracePhase;
+
+
+/**
+ * Enables tracing. From then on, the spans of each thread are kept in a ring buffer of its own, and written to the given file as Chrome trace events when the process receives SIGUSR1 and when it exits.
+ *
+ * @param path The file to write traces to, may not be nil.
+ */
+void SPSTraceStart(NSString *path);
+
+/**
+ * Whether tracing has been enabled.
+ */
+BOOL SPSTraceIsEnabled(void);
+
+/**
+ * Returns the start time of a span, or 0 if tracing is not enabled. Safe to call from any thread.
+ */
+uint64_t SPSTraceBegin(void);
+
+/**
+ * Records a span that started at the given time and ends now, in the buffer of the calling thread. Only takes a lock the first time a thread records a span.
+ *
+ * @param phase The phase the span covers.
+ * @param beginTime A time returned by SPSTraceBegin(). Spans that began while tracing was not enabled are dropped.
+ */
+void SPSTraceEnd(SPSTracePhase phase, uint64_t beginTime);
+
+/**
+ * Writes the spans in the buffers of all threads to the given file, in the Chrome trace event format.
+ *
+ * @return Whether the file could be written.
+ */
+BOOL SPSTraceWriteChromeTrace(NSString *path);
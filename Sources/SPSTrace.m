@@ -0,0 +1,208 @@
+//
+//  SPSTrace.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSTrace.h"
+#import <libkern/OSAtomic.h>
+#include <mach/mach_time.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+
+
+/**
+ * A span, in mach absolute time units.
+ */
+typedef struct {
+	uint64_t beginTime;
+	uint64_t endTime;
+	SPSTracePhase phase;
+} SPSTraceSpan;
+
+/**
+ * The ring buffer of a thread. Buffers are never freed, so that they can be read at any time.
+ */
+typedef struct SPSTraceBuffer {
+	struct SPSTraceBuffer *next;
+	uint64_t threadIdentifier;
+	char threadName[64];
+	volatile uint64_t count;
+	SPSTraceSpan spans[SPS_TRACE_BUFFER_CAPACITY];
+} SPSTraceBuffer;
+
+
+static NSString * const SPSTracePhaseNames[SPSTracePhaseCount] = {
+	@"parse_url",
+	@"target_window",
+	@"dispatch",
+	@"activation",
+	@"connection",
+	@"activate",
+	@"raise_window",
+	@"miniaturize",
+	@"close_window",
+	@"front_window",
+	@"count_tabs",
+	@"make_document",
+	@"set_url",
+	@"open_urls",
+	@"count_windows",
+};
+
+static volatile int32_t SPSTraceEnabled;
+static NSString *SPSTracePath;
+static pthread_key_t SPSTraceBufferKey;
+static SPSTraceBuffer *SPSTraceBuffers;
+static OSSpinLock SPSTraceBuffersLock = OS_SPINLOCK_INIT;
+static dispatch_source_t SPSTraceSignalSource;
+
+
+/**
+ * Returns the buffer of the calling thread, creating it if necessary.
+ */
+static SPSTraceBuffer *SPSTraceCurrentBuffer(void) {
+	SPSTraceBuffer *buffer = pthread_getspecific(SPSTraceBufferKey);
+	if (buffer != NULL) {
+		return buffer;
+	}
+	
+	buffer = calloc(1, sizeof(SPSTraceBuffer));
+	if (buffer == NULL) {
+		return NULL;
+	}
+	
+	buffer->threadIdentifier = pthread_mach_thread_np(pthread_self());
+	pthread_getname_np(pthread_self(), buffer->threadName, sizeof(buffer->threadName));
+	if (buffer->threadName[0] == '\0') {
+		strlcpy(buffer->threadName, pthread_main_np() ? "main" : "thread", sizeof(buffer->threadName));
+	}
+	pthread_setspecific(SPSTraceBufferKey, buffer);
+	
+	OSSpinLockLock(&SPSTraceBuffersLock);
+	buffer->next = SPSTraceBuffers;
+	SPSTraceBuffers = buffer;
+	OSSpinLockUnlock(&SPSTraceBuffersLock);
+	
+	return buffer;
+}
+
+static void SPSTraceWriteAtExit(void) {
+	SPSTraceWriteChromeTrace(SPSTracePath);
+}
+
+
+void SPSTraceStart(NSString *path) {
+	if (SPSTraceIsEnabled()) {
+		return;
+	}
+	
+	SPSTracePath = [path copy];
+	pthread_key_create(&SPSTraceBufferKey, NULL);
+	atexit(SPSTraceWriteAtExit);
+	
+	// Traces are asked for with kill -USR1, and written off the main thread
+	signal(SIGUSR1, SIG_IGN);
+	SPSTraceSignalSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_SIGNAL, SIGUSR1, 0, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0));
+	dispatch_source_set_event_handler(SPSTraceSignalSource, ^{
+		NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+		SPSTraceWriteChromeTrace(SPSTracePath);
+		[pool release];
+	});
+	dispatch_resume(SPSTraceSignalSource);
+	
+	OSAtomicCompareAndSwap32Barrier(0, 1, &SPSTraceEnabled);
+}
+
+BOOL SPSTraceIsEnabled(void) {
+	return SPSTraceEnabled != 0;
+}
+
+uint64_t SPSTraceBegin(void) {
+	return (SPSTraceEnabled != 0) ? mach_absolute_time() : 0;
+}
+
+void SPSTraceEnd(SPSTracePhase phase, uint64_t beginTime) {
+	if (beginTime == 0) {
+		return;
+	}
+	
+	SPSTraceBuffer *buffer = SPSTraceCurrentBuffer();
+	if (buffer == NULL) {
+		return;
+	}
+	
+	// Only the owning thread writes to a buffer, so the span only has to be complete before it is counted
+	SPSTraceSpan *span = &buffer->spans[buffer->count % SPS_TRACE_BUFFER_CAPACITY];
+	span->beginTime = beginTime;
+	span->endTime = mach_absolute_time();
+	span->phase = phase;
+	
+	OSMemoryBarrier();
+	buffer->count++;
+}
+
+BOOL SPSTraceWriteChromeTrace(NSString *path) {
+	FILE *file = fopen([path fileSystemRepresentation], "w");
+	if (file == NULL) {
+		return NO;
+	}
+	
+	mach_timebase_info_data_t timebase;
+	mach_timebase_info(&timebase);
+	double microsecondsPerUnit = (double)timebase.numer / timebase.denom / 1000.0;
+	int processIdentifier = getpid();
+	
+	OSSpinLockLock(&SPSTraceBuffersLock);
+	SPSTraceBuffer *buffers = SPSTraceBuffers;
+	OSSpinLockUnlock(&SPSTraceBuffersLock);
+	
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	BOOL first = YES;
+	
+	// Buffers are only ever added at the head, so the ones seen here stay valid
+	for (SPSTraceBuffer *buffer = buffers; buffer != NULL; buffer = buffer->next) {
+		char threadName[sizeof(buffer->threadName)];
+		strlcpy(threadName, buffer->threadName, sizeof(threadName));
+		for (char *character = threadName; *character != '\0'; character++) {
+			if (*character == '"' || *character == '\\' || *character < ' ') {
+				*character = '_';
+			}
+		}
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%llu,\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", processIdentifier, buffer->threadIdentifier, threadName);
+		first = NO;
+		
+		// A span that is overwritten while it is being read may come out garbled, which is acceptable for a trace
+		uint64_t count = buffer->count;
+		OSMemoryBarrier();
+		uint64_t start = (count > SPS_TRACE_BUFFER_CAPACITY) ? count - SPS_TRACE_BUFFER_CAPACITY : 0;
+		for (uint64_t index = start; index < count; index++) {
+			SPSTraceSpan span = buffer->spans[index % SPS_TRACE_BUFFER_CAPACITY];
+			if (span.phase >= SPSTracePhaseCount || span.endTime < span.beginTime) {
+				continue;
+			}
+			
+			fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f}", [SPSTracePhaseNames[span.phase] UTF8String], processIdentifier, buffer->threadIdentifier, span.beginTime * microsecondsPerUnit, (span.endTime - span.beginTime) * microsecondsPerUnit);
+		}
+	}
+	
+	fprintf(file, "\n]}\n");
+	return (fclose(file) == 0);
+}
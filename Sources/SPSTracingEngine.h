@@ -0,0 +1,42 @@
+//
+//  SPSTracingEngine.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import "SPSScriptingEngine.h"
+
+
+/**
+ * A scripting engine that traces the commands of another engine, as spans named after each command.
+ *
+ * The driver only puts this in front of its engine while tracing is enabled, so that untraced commands do not pay for it.
+ */
+@interface SPSTracingEngine : NSObject <SPSScriptingEngine> {
+	id <SPSScriptingEngine> engine;
+}
+
+/**
+ * Initializes the engine.
+ *
+ * @param anEngine The engine to send commands with, may not be nil.
+ */
+- (id)initWithEngine:(id <SPSScriptingEngine>)anEngine;
+
+@end
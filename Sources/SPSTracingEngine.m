@@ -0,0 +1,122 @@
+//
+//  SPSTracingEngine.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSTracingEngine.h"
+#import "SPSTrace.h"
+
+
+@implementation SPSTracingEngine
+
+- (id)initWithEngine:(id <SPSScriptingEngine>)anEngine {
+	if ((self = [super init])) {
+		engine = [anEngine retain];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[engine release];
+	[super dealloc];
+}
+
+#pragma mark SPSScriptingEngine
+
+- (void)setDelegate:(id <SPSScriptingEngineDelegate>)delegate {
+	[engine setDelegate:delegate];
+}
+
+- (void)setDeadline:(NSTimeInterval)deadline {
+	[engine setDeadline:deadline];
+}
+
+- (void)activate {
+	uint64_t beginTime = SPSTraceBegin();
+	[engine activate];
+	SPSTraceEnd(SPSTracePhaseActivate, beginTime);
+}
+
+- (void)raiseWindow:(NSInteger)windowIdentifier {
+	uint64_t beginTime = SPSTraceBegin();
+	[engine raiseWindow:windowIdentifier];
+	SPSTraceEnd(SPSTracePhaseRaiseWindow, beginTime);
+}
+
+- (void)setMiniaturized:(BOOL)miniaturized ofWindow:(NSInteger)windowIdentifier {
+	uint64_t beginTime = SPSTraceBegin();
+	[engine setMiniaturized:miniaturized ofWindow:windowIdentifier];
+	SPSTraceEnd(SPSTracePhaseMiniaturize, beginTime);
+}
+
+- (void)closeWindow:(NSInteger)windowIdentifier {
+	uint64_t beginTime = SPSTraceBegin();
+	[engine closeWindow:windowIdentifier];
+	SPSTraceEnd(SPSTracePhaseCloseWindow, beginTime);
+}
+
+- (NSInteger)frontWindowIdentifier {
+	uint64_t beginTime = SPSTraceBegin();
+	NSInteger windowIdentifier = [engine frontWindowIdentifier];
+	SPSTraceEnd(SPSTracePhaseFrontWindow, beginTime);
+	return windowIdentifier;
+}
+
+- (NSUInteger)countOfTabsInWindow:(NSInteger)windowIdentifier {
+	uint64_t beginTime = SPSTraceBegin();
+	NSUInteger tabCount = [engine countOfTabsInWindow:windowIdentifier];
+	SPSTraceEnd(SPSTracePhaseCountTabs, beginTime);
+	return tabCount;
+}
+
+- (void)makeDocumentWithURL:(NSURL *)URL {
+	uint64_t beginTime = SPSTraceBegin();
+	[engine makeDocumentWithURL:URL];
+	SPSTraceEnd(SPSTracePhaseMakeDocument, beginTime);
+}
+
+- (void)setURL:(NSURL *)URL ofTab:(NSUInteger)tabIndex inWindow:(NSInteger)windowIdentifier {
+	uint64_t beginTime = SPSTraceBegin();
+	[engine setURL:URL ofTab:tabIndex inWindow:windowIdentifier];
+	SPSTraceEnd(SPSTracePhaseSetURL, beginTime);
+}
+
+- (BOOL)openURLs:(NSArray *)URLs {
+	uint64_t beginTime = SPSTraceBegin();
+	BOOL opened = [engine openURLs:URLs];
+	SPSTraceEnd(SPSTracePhaseOpenURLs, beginTime);
+	return opened;
+}
+
+- (NSUInteger)countOfWindowsOfProcessWithIdentifier:(pid_t)processIdentifier {
+	uint64_t beginTime = SPSTraceBegin();
+	NSUInteger windowCount = [engine countOfWindowsOfProcessWithIdentifier:processIdentifier];
+	SPSTraceEnd(SPSTracePhaseCountWindows, beginTime);
+	return windowCount;
+}
+
+- (NSUInteger)sentCommandCount {
+	return [engine sentCommandCount];
+}
+
+- (void)reset {
+	[engine reset];
+}
+
+@end
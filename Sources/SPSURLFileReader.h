@@ -0,0 +1,67 @@
+//
+//  SPSURLFileReader.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ * Streams the URLs of a file with one URL per line, through a memory mapping.
+ *
+ * Pages are mapped for sequential access and given back once they have been read past, so that the reader takes about the same memory for a file of any size. Empty lines and lines starting with # are skipped.
+ */
+@interface SPSURLFileReader : NSObject {
+	int fileDescriptor;
+	const char *bytes;
+	size_t length;
+	size_t position;
+	size_t releasedLength;
+	NSUInteger invalidLineCount;
+}
+
+/**
+ * Initializes the reader.
+ *
+ * @param path The path of the file, may not be nil.
+ * @return The reader, or nil if the file could not be mapped.
+ */
+- (id)initWithPath:(NSString *)path;
+
+/**
+ * Returns the next URL, or nil at the end of the file. Lines that are not URLs are skipped, and counted as invalid.
+ */
+- (NSURL *)nextURL;
+
+/**
+ * The number of lines read so far that are not URLs, other than empty lines and comments.
+ */
+- (NSUInteger)invalidLineCount;
+
+/**
+ * The size of the file, in bytes.
+ */
+- (unsigned long long)length;
+
+/**
+ * The number of bytes read so far.
+ */
+- (unsigned long long)position;
+
+@end
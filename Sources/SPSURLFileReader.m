@@ -0,0 +1,124 @@
+//
+//  SPSURLFileReader.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSURLFileReader.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+/**
+ * The number of bytes read past before they are given back, in bytes.
+ */
+#define SPS_URL_FILE_RELEASE_LENGTH (1024 * 1024)
+
+
+@implementation SPSURLFileReader
+
+- (id)initWithPath:(NSString *)path {
+	if ((self = [super init])) {
+		fileDescriptor = open([path fileSystemRepresentation], O_RDONLY);
+		
+		struct stat status;
+		if (fileDescriptor == -1 || fstat(fileDescriptor, &status) != 0) {
+			[self release];
+			return nil;
+		}
+		
+		// An empty file cannot be mapped, but is read as having no URLs
+		length = (size_t)status.st_size;
+		if (length > 0) {
+			void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+			if (mapping == MAP_FAILED) {
+				[self release];
+				return nil;
+			}
+			
+			bytes = mapping;
+			madvise(mapping, length, MADV_SEQUENTIAL);
+		}
+	}
+	return self;
+}
+
+- (void)dealloc {
+	if (bytes != NULL) {
+		munmap((void *)bytes, length);
+	}
+	if (fileDescriptor != -1) {
+		close(fileDescriptor);
+	}
+	[super dealloc];
+}
+
+- (NSURL *)nextURL {
+	while (position < length) {
+		const char *line = bytes + position;
+		const char *lineEnd = memchr(line, '\n', length - position);
+		size_t lineLength = (lineEnd != NULL) ? (size_t)(lineEnd - line) : length - position;
+		position += lineLength + ((lineEnd != NULL) ? 1 : 0);
+		
+		// Give back what has been read, in whole pages, so that the mapping does not keep growing
+		if (position - releasedLength >= SPS_URL_FILE_RELEASE_LENGTH) {
+			size_t pageSize = (size_t)getpagesize();
+			size_t releaseEnd = position / pageSize * pageSize;
+			madvise((void *)(bytes + releasedLength), releaseEnd - releasedLength, MADV_DONTNEED);
+			releasedLength = releaseEnd;
+		}
+		
+		while (lineLength > 0 && (line[lineLength - 1] == '\r' || line[lineLength - 1] == ' ' || line[lineLength - 1] == '\t')) {
+			lineLength--;
+		}
+		while (lineLength > 0 && (line[0] == ' ' || line[0] == '\t')) {
+			line++;
+			lineLength--;
+		}
+		if (lineLength == 0 || line[0] == '#') {
+			continue;
+		}
+		
+		NSString *URLString = [[NSString alloc] initWithBytes:line length:lineLength encoding:NSUTF8StringEncoding];
+		NSURL *URL = (URLString != nil) ? [NSURL URLWithString:URLString] : nil;
+		[URLString release];
+		
+		if (URL != nil) {
+			return URL;
+		}
+		invalidLineCount++;
+	}
+	
+	return nil;
+}
+
+- (NSUInteger)invalidLineCount {
+	return invalidLineCount;
+}
+
+- (unsigned long long)length {
+	return length;
+}
+
+- (unsigned long long)position {
+	return position;
+}
+
+@end
@@ -0,0 +1,119 @@
+//
+//  SPSURLRequest.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ * The time within which a URL should be dispatched after it was received, in seconds. Apple Events for the URL only wait for what is left of it.
+ */
+#define SPS_URL_REQUEST_BUDGET 5.0
+
+
+/**
+ * A request to open a URL in Safari, along with its outcome once it has been dispatched.
+ */
+@interface SPSURLRequest : NSObject {
+	NSURL *URL;
+	NSAppleEventManagerSuspensionID suspensionID;
+	NSTimeInterval creationTime;
+	NSTimeInterval deadline;
+	volatile int32_t cancelled;
+	NSInteger windowIdentifier;
+	NSInteger tabIndex;
+	BOOL opensInNewWindow;
+	BOOL duplicate;
+	NSError *error;
+	void (^completionHandler)(SPSURLRequest *request);
+}
+
+/**
+ * Initializes the request.
+ *
+ * @param aURL A URL, may not be nil.
+ * @param aSuspensionID The suspended Apple Event to reply to, or NULL if there is none.
+ * @param aDeadline The time by which the URL should have been dispatched, as returned by +[NSDate timeIntervalSinceReferenceDate].
+ */
+- (id)initWithURL:(NSURL *)aURL suspensionID:(NSAppleEventManagerSuspensionID)aSuspensionID deadline:(NSTimeInterval)aDeadline;
+
+/**
+ * Marks the request as cancelled, for example because its sender has gone away. May be called from any thread.
+ *
+ * A cancelled request gets a userCanceledErr error, and no more Apple Events are sent for it than were already underway.
+ */
+- (void)cancel;
+
+/**
+ * Whether the request has been cancelled. May be called from any thread.
+ */
+- (BOOL)isCancelled;
+
+/**
+ * The URL to open.
+ */
+@property (readonly) NSURL *URL;
+
+/**
+ * The suspended Apple Event to reply to, or NULL if there is none.
+ */
+@property (readonly) NSAppleEventManagerSuspensionID suspensionID;
+
+/**
+ * The time at which the request was made, as returned by +[NSDate timeIntervalSinceReferenceDate].
+ */
+@property (readonly) NSTimeInterval creationTime;
+
+/**
+ * The time by which the URL should have been dispatched, as returned by +[NSDate timeIntervalSinceReferenceDate].
+ */
+@property (readonly) NSTimeInterval deadline;
+
+/**
+ * The identifier of the Safari window that the URL was opened in, or 0 if it is not known.
+ */
+@property NSInteger windowIdentifier;
+
+/**
+ * The one-based index of the tab that the URL was opened in, or 0 if it is not known.
+ */
+@property NSInteger tabIndex;
+
+/**
+ * Whether the URL should be opened in a new window in the current space, rather than in the window last used there. Only the first request of a batch decides this for the whole batch.
+ */
+@property BOOL opensInNewWindow;
+
+/**
+ * Whether the request was for a URL that an earlier request was still opening, and took on the outcome of that request instead of opening another tab.
+ */
+@property (getter=isDuplicate) BOOL duplicate;
+
+/**
+ * The error that prevented the URL from being opened, or nil if it was opened.
+ */
+@property (retain) NSError *error;
+
+/**
+ * A block that is called on the main thread once the request has been dispatched, or nil. Used by callers that do not wait for an Apple Event reply.
+ */
+@property (copy) void (^completionHandler)(SPSURLRequest *request);
+
+@end
@@ -0,0 +1,64 @@
+//
+//  SPSURLRequest.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSURLRequest.h"
+#import <libkern/OSAtomic.h>
+
+
+@implementation SPSURLRequest
+
+@synthesize URL;
+@synthesize suspensionID;
+@synthesize creationTime;
+@synthesize deadline;
+@synthesize windowIdentifier;
+@synthesize tabIndex;
+@synthesize opensInNewWindow;
+@synthesize duplicate;
+@synthesize error;
+@synthesize completionHandler;
+
+- (id)initWithURL:(NSURL *)aURL suspensionID:(NSAppleEventManagerSuspensionID)aSuspensionID deadline:(NSTimeInterval)aDeadline {
+	if ((self = [super init])) {
+		URL = [aURL retain];
+		suspensionID = aSuspensionID;
+		creationTime = [NSDate timeIntervalSinceReferenceDate];
+		deadline = aDeadline;
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[URL release];
+	[error release];
+	[completionHandler release];
+	[super dealloc];
+}
+
+- (void)cancel {
+	OSAtomicCompareAndSwap32Barrier(0, 1, &cancelled);
+}
+
+- (BOOL)isCancelled {
+	return OSAtomicAdd32Barrier(0, &cancelled) != 0;
+}
+
+@end
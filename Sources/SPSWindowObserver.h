@@ -0,0 +1,102 @@
+//
+//  SPSWindowObserver.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import <ApplicationServices/ApplicationServices.h>
+
+
+@class SPSWindowObserver;
+
+
+/**
+ * Receives window changes from a window observer. Called on the main thread.
+ */
+@protocol SPSWindowObserverDelegate <NSObject>
+
+/**
+ * Called when the observed process has created a window, which is in the active space.
+ */
+- (void)windowObserver:(SPSWindowObserver *)observer didObserveCreationOfWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Called when a window of the observed process has been closed.
+ */
+- (void)windowObserver:(SPSWindowObserver *)observer didObserveDestructionOfWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Called when a window of the observed process has become its main window, the one in front of its other windows.
+ */
+- (void)windowObserver:(SPSWindowObserver *)observer didObserveFrontWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Called when the observer cannot vouch for the changes it reported, for example because a window could not be identified.
+ */
+- (void)windowObserverDidLoseTrack:(SPSWindowObserver *)observer;
+
+/**
+ * Called once the observer has been set up and receives notifications. Windows created before then may not have been reported.
+ */
+- (void)windowObserverDidStartObserving:(SPSWindowObserver *)observer;
+
+@end
+
+
+/**
+ * Observes the creation and destruction of the windows of a process, and which of them is in front, through accessibility notifications.
+ *
+ * This only works if access for assistive devices is enabled. If it is not, the observer does not observe anything, which isObserving tells.
+ *
+ * Setting up takes a round trip to the process for every window it has, which takes as long as the process does to answer. It is therefore done in the background, and the observer only reports changes once it is done.
+ */
+@interface SPSWindowObserver : NSObject {
+	id <SPSWindowObserverDelegate> delegate;
+	pid_t processIdentifier;
+	AXObserverRef observer;
+	AXUIElementRef applicationElement;
+	CFMutableDictionaryRef windowIdentifiersByElement;
+	BOOL ready;
+	BOOL invalidated;
+}
+
+/**
+ * Initializes the observer and starts setting it up in the background. Once set up, it observes on the main run loop.
+ *
+ * @param aProcessIdentifier The process whose windows to observe.
+ * @param aDelegate The object to tell about changes. Not retained.
+ */
+- (id)initWithProcessIdentifier:(pid_t)aProcessIdentifier delegate:(id <SPSWindowObserverDelegate>)aDelegate;
+
+/**
+ * Stops observing. Must be called before the observer is released, since the run loop refers to it.
+ */
+- (void)invalidate;
+
+/**
+ * Whether the observer has been set up and receives notifications. Until then, changes go unreported.
+ */
+- (BOOL)isObserving;
+
+/**
+ * The observed process.
+ */
+- (pid_t)processIdentifier;
+
+@end
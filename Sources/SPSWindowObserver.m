@@ -0,0 +1,204 @@
+//
+//  SPSWindowObserver.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSWindowObserver.h"
+
+
+/*
+ * Private accessibility function for finding out the window server window number of a window element, which has no public API.
+ */
+extern AXError _AXUIElementGetWindow(AXUIElementRef element, CGWindowID *windowIdentifier);
+
+
+@interface SPSWindowObserver ()
+
+/**
+ * Creates the accessibility observer and watches the windows that exist already. Runs in the background, and only touches the observer's accessibility objects, which the main thread leaves alone until it is done.
+ */
+- (void)setUp;
+
+/**
+ * Starts receiving notifications on the main run loop once set up, or throws away what was set up if the observer was invalidated meanwhile. Called on the main thread.
+ */
+- (void)finishSetUp;
+
+/**
+ * Handles an accessibility notification.
+ */
+- (void)observeNotification:(CFStringRef)notification element:(AXUIElementRef)element;
+
+/**
+ * Starts watching the given window for destruction.
+ *
+ * @return Whether the window could be identified and watched.
+ */
+- (BOOL)watchWindowElement:(AXUIElementRef)element;
+
+@end
+
+
+static void SPSWindowObserverCallback(AXObserverRef observer, AXUIElementRef element, CFStringRef notification, void *context) {
+	[(SPSWindowObserver *)context observeNotification:notification element:element];
+}
+
+
+@implementation SPSWindowObserver
+
+- (id)initWithProcessIdentifier:(pid_t)aProcessIdentifier delegate:(id <SPSWindowObserverDelegate>)aDelegate {
+	if ((self = [super init])) {
+		processIdentifier = aProcessIdentifier;
+		delegate = aDelegate;
+		windowIdentifiersByElement = CFDictionaryCreateMutable(NULL, 0, &kCFTypeDictionaryKeyCallBacks, &kCFTypeDictionaryValueCallBacks);
+		
+		// A process that does not answer would otherwise hold up whoever asked for the observer; the blocks keep the observer around until they are done
+		dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+			[self setUp];
+			
+			dispatch_async(dispatch_get_main_queue(), ^{
+				[self finishSetUp];
+			});
+		});
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[self invalidate];
+	CFRelease(windowIdentifiersByElement);
+	[super dealloc];
+}
+
+- (void)invalidate {
+	// What is still being set up is thrown away once it is done
+	invalidated = YES;
+	if (!ready) {
+		return;
+	}
+	
+	if (observer != NULL) {
+		CFRunLoopRemoveSource(CFRunLoopGetMain(), AXObserverGetRunLoopSource(observer), kCFRunLoopDefaultMode);
+		CFRelease(observer);
+		observer = NULL;
+	}
+	if (applicationElement != NULL) {
+		CFRelease(applicationElement);
+		applicationElement = NULL;
+	}
+	CFDictionaryRemoveAllValues(windowIdentifiersByElement);
+}
+
+- (BOOL)isObserving {
+	return ready && observer != NULL;
+}
+
+- (pid_t)processIdentifier {
+	return processIdentifier;
+}
+
+- (void)setUp {
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+	
+	if (AXAPIEnabled() && AXObserverCreate(processIdentifier, SPSWindowObserverCallback, &observer) == kAXErrorSuccess) {
+		applicationElement = AXUIElementCreateApplication(processIdentifier);
+		
+		if (AXObserverAddNotification(observer, applicationElement, kAXWindowCreatedNotification, self) == kAXErrorSuccess && AXObserverAddNotification(observer, applicationElement, kAXMainWindowChangedNotification, self) == kAXErrorSuccess) {
+			// Watch the windows that exist already, so that we hear about them closing
+			CFArrayRef windowElements = NULL;
+			if (AXUIElementCopyAttributeValues(applicationElement, kAXWindowsAttribute, 0, 1024, &windowElements) == kAXErrorSuccess) {
+				for (id windowElement in (NSArray *)windowElements) {
+					[self watchWindowElement:(AXUIElementRef)windowElement];
+				}
+				CFRelease(windowElements);
+			}
+		}
+		else {
+			CFRelease(observer);
+			observer = NULL;
+		}
+	}
+	
+	[pool drain];
+}
+
+- (void)finishSetUp {
+	ready = YES;
+	
+	if (invalidated) {
+		[self invalidate];
+		return;
+	}
+	
+	// Notifications that came in while setting up are delivered from here on
+	if (observer != NULL) {
+		CFRunLoopAddSource(CFRunLoopGetMain(), AXObserverGetRunLoopSource(observer), kCFRunLoopDefaultMode);
+		[delegate windowObserverDidStartObserving:self];
+	}
+}
+
+- (void)observeNotification:(CFStringRef)notification element:(AXUIElementRef)element {
+	if (CFEqual(notification, kAXWindowCreatedNotification)) {
+		if ([self watchWindowElement:element]) {
+			NSNumber *windowIdentifier = (NSNumber *)CFDictionaryGetValue(windowIdentifiersByElement, element);
+			[delegate windowObserver:self didObserveCreationOfWindow:[windowIdentifier integerValue]];
+		}
+		else {
+			[delegate windowObserverDidLoseTrack:self];
+		}
+	}
+	else if (CFEqual(notification, kAXMainWindowChangedNotification)) {
+		CGWindowID windowIdentifier = 0;
+		
+		if (_AXUIElementGetWindow(element, &windowIdentifier) == kAXErrorSuccess) {
+			[delegate windowObserver:self didObserveFrontWindow:windowIdentifier];
+		}
+		else {
+			[delegate windowObserverDidLoseTrack:self];
+		}
+	}
+	else if (CFEqual(notification, kAXUIElementDestroyedNotification)) {
+		// The element is gone, so its window number can only be found in our own records
+		NSNumber *windowIdentifier = [[(NSNumber *)CFDictionaryGetValue(windowIdentifiersByElement, element) retain] autorelease];
+		
+		if (windowIdentifier != nil) {
+			CFDictionaryRemoveValue(windowIdentifiersByElement, element);
+			[delegate windowObserver:self didObserveDestructionOfWindow:[windowIdentifier integerValue]];
+		}
+		else {
+			[delegate windowObserverDidLoseTrack:self];
+		}
+	}
+}
+
+- (BOOL)watchWindowElement:(AXUIElementRef)element {
+	CGWindowID windowIdentifier = 0;
+	
+	if (_AXUIElementGetWindow(element, &windowIdentifier) != kAXErrorSuccess) {
+		return NO;
+	}
+	if (AXObserverAddNotification(observer, element, kAXUIElementDestroyedNotification, self) != kAXErrorSuccess) {
+		return NO;
+	}
+	
+	CFDictionarySetValue(windowIdentifiersByElement, element, [NSNumber numberWithUnsignedInt:windowIdentifier]);
+	return YES;
+}
+
+@end
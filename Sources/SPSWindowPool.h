@@ -0,0 +1,121 @@
+//
+//  SPSWindowPool.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#import <Foundation/Foundation.h>
+
+
+/**
+ * The largest number of windows the pool holds by default.
+ */
+#define SPS_WINDOW_POOL_CAPACITY 4
+
+/**
+ * The time after which an unclaimed window is evicted by default, in seconds.
+ */
+#define SPS_WINDOW_POOL_IDLE_TIMEOUT 600.0
+
+
+/**
+ * Keeps track of blank windows that were made in advance, at most one per space, so that a link arriving in a space without a window can be opened in one right away.
+ *
+ * The pool holds a limited number of windows. Windows that have not been claimed for a while are handed back to be closed, so that they do not hold on to memory forever.
+ *
+ * The pool does not keep time itself. All times are passed in by the caller, in seconds.
+ */
+@interface SPSWindowPool : NSObject {
+	NSMutableDictionary *entriesBySpaceIdentifier;
+	NSUInteger capacity;
+	NSTimeInterval idleTimeout;
+}
+
+/**
+ * Initializes the pool.
+ *
+ * @param aCapacity The largest number of windows the pool may hold, including windows that are still being made.
+ * @param anIdleTimeout The time after which an unclaimed window is evicted.
+ */
+- (id)initWithCapacity:(NSUInteger)aCapacity idleTimeout:(NSTimeInterval)anIdleTimeout;
+
+/**
+ * Returns the time after which an unclaimed window is evicted.
+ */
+- (NSTimeInterval)idleTimeout;
+
+/**
+ * Returns whether a window should be made for the given space: it has none, none is being made, and the pool has room.
+ */
+- (BOOL)shouldMakeWindowForSpace:(NSInteger)spaceIdentifier;
+
+/**
+ * Records that a window is being made for the given space, so that no second one is made in the meantime.
+ */
+- (void)beginMakingWindowForSpace:(NSInteger)spaceIdentifier;
+
+/**
+ * Records that the window that was being made for the given space will not come, so that another one can be made.
+ */
+- (void)cancelMakingWindowForSpace:(NSInteger)spaceIdentifier;
+
+/**
+ * Whether a window is being made for any space.
+ */
+- (BOOL)isMakingWindow;
+
+/**
+ * Records the window that was made for the given space.
+ *
+ * @param windowIdentifier The new window, may not be 0. A window that could not be made is recorded with cancelMakingWindowForSpace:.
+ * @param spaceIdentifier The space the window was made in.
+ * @param byteCount The memory that the window takes up in Safari, as far as it is known.
+ * @param time The time at which the window was made.
+ */
+- (void)addWindow:(NSInteger)windowIdentifier forSpace:(NSInteger)spaceIdentifier byteCount:(int64_t)byteCount atTime:(NSTimeInterval)time;
+
+/**
+ * Whether the given window is held by the pool.
+ */
+- (BOOL)containsWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Takes the window of the given space out of the pool, counting a hit or a miss.
+ *
+ * @return The window to use, or 0 if the pool has none for the space.
+ */
+- (NSInteger)claimWindowForSpace:(NSInteger)spaceIdentifier;
+
+/**
+ * Forgets a window, for example because it was closed by the user.
+ */
+- (void)removeWindow:(NSInteger)windowIdentifier;
+
+/**
+ * Takes the windows that have gone unclaimed for too long out of the pool.
+ *
+ * @param time The current time.
+ * @return The evicted windows, as NSNumber objects, which the caller should close.
+ */
+- (NSArray *)evictIdleWindowsAtTime:(NSTimeInterval)time;
+
+/**
+ * Forgets all windows, for example because Safari has exited.
+ */
+- (void)removeAllWindows;
+
+@end
@@ -0,0 +1,175 @@
+//
+//  SPSWindowPool.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#import "SPSWindowPool.h"
+#import "SPSMetrics.h"
+
+
+/*
+ * Keys of the entries of the pool.
+ */
+#define SPSWindowPoolWindowKey @"window"
+#define SPSWindowPoolByteCountKey @"byteCount"
+#define SPSWindowPoolTimeKey @"time"
+
+
+@interface SPSWindowPool ()
+
+/**
+ * Removes the entry of the given space, updating the gauges.
+ */
+- (void)removeEntryForSpace:(NSNumber *)spaceKey;
+
+@end
+
+
+@implementation SPSWindowPool
+
+- (id)init {
+	return [self initWithCapacity:SPS_WINDOW_POOL_CAPACITY idleTimeout:SPS_WINDOW_POOL_IDLE_TIMEOUT];
+}
+
+- (id)initWithCapacity:(NSUInteger)aCapacity idleTimeout:(NSTimeInterval)anIdleTimeout {
+	if ((self = [super init])) {
+		entriesBySpaceIdentifier = [[NSMutableDictionary alloc] init];
+		capacity = aCapacity;
+		idleTimeout = anIdleTimeout;
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[self removeAllWindows];
+	[entriesBySpaceIdentifier release];
+	[super dealloc];
+}
+
+- (NSTimeInterval)idleTimeout {
+	return idleTimeout;
+}
+
+- (BOOL)shouldMakeWindowForSpace:(NSInteger)spaceIdentifier {
+	return [entriesBySpaceIdentifier objectForKey:[NSNumber numberWithInteger:spaceIdentifier]] == nil && [entriesBySpaceIdentifier count] < capacity;
+}
+
+- (void)beginMakingWindowForSpace:(NSInteger)spaceIdentifier {
+	// An entry without a window stands for one that is on its way
+	[entriesBySpaceIdentifier setObject:[NSDictionary dictionary] forKey:[NSNumber numberWithInteger:spaceIdentifier]];
+}
+
+- (void)cancelMakingWindowForSpace:(NSInteger)spaceIdentifier {
+	NSNumber *spaceKey = [NSNumber numberWithInteger:spaceIdentifier];
+	
+	if ([[entriesBySpaceIdentifier objectForKey:spaceKey] objectForKey:SPSWindowPoolWindowKey] == nil) {
+		[self removeEntryForSpace:spaceKey];
+	}
+}
+
+- (BOOL)isMakingWindow {
+	for (NSDictionary *entry in [entriesBySpaceIdentifier objectEnumerator]) {
+		if ([entry objectForKey:SPSWindowPoolWindowKey] == nil) {
+			return YES;
+		}
+	}
+	return NO;
+}
+
+- (void)addWindow:(NSInteger)windowIdentifier forSpace:(NSInteger)spaceIdentifier byteCount:(int64_t)byteCount atTime:(NSTimeInterval)time {
+	NSNumber *spaceKey = [NSNumber numberWithInteger:spaceIdentifier];
+	[self removeEntryForSpace:spaceKey];
+	
+	NSDictionary *entry = [NSDictionary dictionaryWithObjectsAndKeys:
+		[NSNumber numberWithInteger:windowIdentifier], SPSWindowPoolWindowKey,
+		[NSNumber numberWithLongLong:byteCount], SPSWindowPoolByteCountKey,
+		[NSNumber numberWithDouble:time], SPSWindowPoolTimeKey,
+		nil];
+	[entriesBySpaceIdentifier setObject:entry forKey:spaceKey];
+	
+	SPSCounterAdd(SPSCounterWindowPoolCreations, 1);
+	SPSCounterAdd(SPSCounterWindowPoolWindows, 1);
+	SPSCounterAdd(SPSCounterWindowPoolBytes, byteCount);
+}
+
+- (BOOL)containsWindow:(NSInteger)windowIdentifier {
+	for (NSDictionary *entry in [entriesBySpaceIdentifier objectEnumerator]) {
+		if ([[entry objectForKey:SPSWindowPoolWindowKey] integerValue] == windowIdentifier) {
+			return YES;
+		}
+	}
+	return NO;
+}
+
+- (NSInteger)claimWindowForSpace:(NSInteger)spaceIdentifier {
+	NSNumber *spaceKey = [NSNumber numberWithInteger:spaceIdentifier];
+	NSInteger windowIdentifier = [[[entriesBySpaceIdentifier objectForKey:spaceKey] objectForKey:SPSWindowPoolWindowKey] integerValue];
+	
+	if (windowIdentifier > 0) {
+		SPSCounterAdd(SPSCounterWindowPoolHits, 1);
+		[self removeEntryForSpace:spaceKey];
+	}
+	else {
+		SPSCounterAdd(SPSCounterWindowPoolMisses, 1);
+	}
+	
+	return windowIdentifier;
+}
+
+- (void)removeWindow:(NSInteger)windowIdentifier {
+	for (NSNumber *spaceKey in [entriesBySpaceIdentifier allKeys]) {
+		if ([[[entriesBySpaceIdentifier objectForKey:spaceKey] objectForKey:SPSWindowPoolWindowKey] integerValue] == windowIdentifier) {
+			[self removeEntryForSpace:spaceKey];
+		}
+	}
+}
+
+- (NSArray *)evictIdleWindowsAtTime:(NSTimeInterval)time {
+	NSMutableArray *evictedWindowIdentifiers = [NSMutableArray array];
+	
+	for (NSNumber *spaceKey in [entriesBySpaceIdentifier allKeys]) {
+		NSDictionary *entry = [entriesBySpaceIdentifier objectForKey:spaceKey];
+		NSNumber *windowIdentifier = [entry objectForKey:SPSWindowPoolWindowKey];
+		
+		if (windowIdentifier != nil && time - [[entry objectForKey:SPSWindowPoolTimeKey] doubleValue] >= idleTimeout) {
+			SPSCounterAdd(SPSCounterWindowPoolEvictions, 1);
+			[evictedWindowIdentifiers addObject:windowIdentifier];
+			[self removeEntryForSpace:spaceKey];
+		}
+	}
+	
+	return evictedWindowIdentifiers;
+}
+
+- (void)removeAllWindows {
+	for (NSNumber *spaceKey in [entriesBySpaceIdentifier allKeys]) {
+		[self removeEntryForSpace:spaceKey];
+	}
+}
+
+- (void)removeEntryForSpace:(NSNumber *)spaceKey {
+	NSDictionary *entry = [entriesBySpaceIdentifier objectForKey:spaceKey];
+	
+	if ([entry objectForKey:SPSWindowPoolWindowKey] != nil) {
+		SPSCounterAdd(SPSCounterWindowPoolWindows, -1);
+		SPSCounterAdd(SPSCounterWindowPoolBytes, -[[entry objectForKey:SPSWindowPoolByteCountKey] longLongValue]);
+	}
+	[entriesBySpaceIdentifier removeObjectForKey:spaceKey];
+}
+
+@end
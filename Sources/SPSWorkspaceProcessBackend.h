@@ -0,0 +1,35 @@
+//
+//  SPSWorkspaceProcessBackend.h
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import <Cocoa/Cocoa.h>
+#import "SPSProcessRegistry.h"
+
+
+/**
+ * A process backend that uses NSWorkspace and its launch and termination notifications.
+ *
+ * Kept apart from the registry, which only needs Foundation, so that the registry can be built and tested without AppKit.
+ */
+@interface SPSWorkspaceProcessBackend : NSObject <SPSProcessBackend> {
+	id <SPSProcessBackendDelegate> delegate;
+}
+
+@end
@@ -0,0 +1,76 @@
+//
+//  SPSWorkspaceProcessBackend.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#import "SPSWorkspaceProcessBackend.h"
+
+
+@implementation SPSWorkspaceProcessBackend
+
+- (id)init {
+	if ((self = [super init])) {
+		NSNotificationCenter *notificationCenter = [[NSWorkspace sharedWorkspace] notificationCenter];
+		[notificationCenter addObserver:self selector:@selector(workspaceDidLaunchApplication:) name:NSWorkspaceDidLaunchApplicationNotification object:nil];
+		[notificationCenter addObserver:self selector:@selector(workspaceDidTerminateApplication:) name:NSWorkspaceDidTerminateApplicationNotification object:nil];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[[[NSWorkspace sharedWorkspace] notificationCenter] removeObserver:self];
+	[super dealloc];
+}
+
+#pragma mark NSWorkspace notifications
+
+- (void)workspaceDidLaunchApplication:(NSNotification *)notification {
+	NSRunningApplication *application = [[notification userInfo] objectForKey:NSWorkspaceApplicationKey];
+	NSString *bundleIdentifier = [application bundleIdentifier];
+
+	if (bundleIdentifier != nil) {
+		[delegate processBackend:self didLaunchProcessWithIdentifier:[application processIdentifier] bundleIdentifier:bundleIdentifier];
+	}
+}
+
+- (void)workspaceDidTerminateApplication:(NSNotification *)notification {
+	NSRunningApplication *application = [[notification userInfo] objectForKey:NSWorkspaceApplicationKey];
+	[delegate processBackend:self didTerminateProcessWithIdentifier:[application processIdentifier]];
+}
+
+#pragma mark SPSProcessBackend
+
+- (id <SPSProcessBackendDelegate>)delegate {
+	return delegate;
+}
+
+- (void)setDelegate:(id <SPSProcessBackendDelegate>)aDelegate {
+	delegate = aDelegate;
+}
+
+- (void)enumerateProcessesUsingBlock:(void (^)(pid_t processIdentifier, NSString *bundleIdentifier))block {
+	for (NSRunningApplication *application in [[NSWorkspace sharedWorkspace] runningApplications]) {
+		NSString *bundleIdentifier = [application bundleIdentifier];
+		if (bundleIdentifier != nil) {
+			block([application processIdentifier], bundleIdentifier);
+		}
+	}
+}
+
+@end
@@ -20,8 +20,35 @@
 //
 
 #import <Cocoa/Cocoa.h>
+#import "SPSApplicationController.h"
+#import "SPSTrace.h"
 
 
 int main(int argc, const char *argv[]) {
-	return NSApplicationMain(argc, argv);
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+	NSApplication *application = [NSApplication sharedApplication];
+	
+	// Tracing has to be on before the driver is made, which only puts its tracing engine in place then
+	NSString *tracePath = [[NSUserDefaults standardUserDefaults] stringForKey:SPS_TRACE_FILE_DEFAULT];
+	if (tracePath != nil) {
+		SPSTraceStart([tracePath stringByExpandingTildeInPath]);
+	}
+	
+	// LSUIElement keeps the agent out of the Dock, so an ordinary launch asks for its Dock icon and loads the nib as before
+	if (![[NSUserDefaults standardUserDefaults] boolForKey:SPS_AGENT_MODE_DEFAULT]) {
+		[application setActivationPolicy:NSApplicationActivationPolicyRegular];
+		[pool release];
+		
+		return NSApplicationMain(argc, argv);
+	}
+	
+	// The agent skips decoding the nib and setting up a menu, and builds its delegate in code
+	SPSApplicationController *controller = [[SPSApplicationController alloc] init];
+	[application setDelegate:controller];
+	[pool release];
+	
+	[application run];
+	
+	[controller release];
+	return 0;
 }
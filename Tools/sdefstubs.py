@@ -0,0 +1,186 @@
+#!/usr/bin/env python
+#
+#  sdefstubs.py
+#  Spatial Safari
+#
+#  Created by agent on 17-10-2026.
+#  Copyright 2026 agent.
+#  
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#  
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#  
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+"""
+Generates a header with static stubs for the parts of a scripting dictionary that are actually used.
+
+Instead of the full ScriptingBridge interface that sdp produces, which makes ScriptingBridge load and
+parse the whole dictionary at runtime, the header only contains the four-character codes of the given
+classes, properties and elements, and a specifier function for every property.
+
+Usage:
+
+	sdef /Applications/Safari.app | Tools/sdefstubs.py SPSSafari Sources/SPSSafariCodes.h \\
+		"application.documents" "window.tabs" "tab.URL" "document.URL"
+
+Every member is given as "class.property" or "class.elements", with the names as they appear in the
+dictionary. A member that cannot be found is an error, so that a changed dictionary breaks the build
+instead of the program: the "Generate Apple Event Stubs" phase of the application target runs the
+generator for SPSSafariCodes.h and SPSSystemEventsCodes.h before anything is compiled. A member that
+is added there has to be added to the phase as well.
+"""
+
+import os
+import sys
+import xml.dom.minidom
+
+
+def identifier(name):
+	"""Turns a dictionary name like "unix id" into an identifier part like "UnixId"."""
+	return ''.join(word[0].upper() + word[1:] for word in name.replace('-', ' ').split())
+
+
+class Dictionary(object):
+	"""The classes of a scripting dictionary, with their properties and elements."""
+	
+	def __init__(self, document):
+		self.classes = {}
+		self.pluralNames = {}
+		
+		for node in document.getElementsByTagName('class'):
+			self.addClass(node.getAttribute('name'), node)
+			self.codes(node.getAttribute('name'))['code'] = node.getAttribute('code')
+			self.codes(node.getAttribute('name'))['inherits'] = node.getAttribute('inherits')
+			
+			plural = node.getAttribute('plural') or node.getAttribute('name') + 's'
+			self.pluralNames[plural] = node.getAttribute('name')
+		
+		# Class extensions add members to classes that may be defined in other suites
+		for node in document.getElementsByTagName('class-extension'):
+			self.addClass(node.getAttribute('extends'), node)
+	
+	def codes(self, className):
+		return self.classes.setdefault(className, {'code': None, 'inherits': None, 'properties': {}, 'elements': []})
+	
+	def addClass(self, className, node):
+		entry = self.codes(className)
+		for child in node.childNodes:
+			if child.nodeType != child.ELEMENT_NODE:
+				continue
+			if child.tagName == 'property':
+				entry['properties'][child.getAttribute('name')] = (child.getAttribute('code'), child.getAttribute('description'))
+			elif child.tagName == 'element':
+				entry['elements'].append(child.getAttribute('type'))
+	
+	def classCode(self, className):
+		entry = self.classes.get(className)
+		if entry is None or not entry['code']:
+			raise KeyError('no class "%s"' % className)
+		return entry['code']
+	
+	def property(self, className, propertyName):
+		"""Looks up a property of the given class or of one of the classes it inherits from."""
+		while className:
+			entry = self.classes.get(className)
+			if entry is None:
+				break
+			if propertyName in entry['properties']:
+				return entry['properties'][propertyName]
+			className = entry['inherits']
+		raise KeyError('no property "%s"' % propertyName)
+	
+	def element(self, className, pluralName):
+		"""Looks up the class of the elements with the given plural name."""
+		elementClass = self.pluralNames.get(pluralName, pluralName)
+		while className:
+			entry = self.classes.get(className)
+			if entry is None:
+				break
+			if elementClass in entry['elements']:
+				return elementClass
+			className = entry['inherits']
+		raise KeyError('no elements "%s"' % pluralName)
+
+
+def generate(dictionary, prefix, outputName, members):
+	classes = []
+	properties = []
+	
+	def addClass(className):
+		if className not in [name for name, code in classes]:
+			classes.append((className, dictionary.classCode(className)))
+	
+	for member in members:
+		className, memberName = member.split('.', 1)
+		try:
+			addClass(className)
+			try:
+				code, description = dictionary.property(className, memberName)
+				properties.append((className, memberName, code, description))
+			except KeyError:
+				addClass(dictionary.element(className, memberName))
+		except KeyError as error:
+			raise SystemExit('%s: %s in "%s"' % (os.path.basename(sys.argv[0]), error.args[0], member))
+	
+	lines = []
+	lines.append('/*')
+	lines.append(' * %s' % os.path.basename(outputName))
+	lines.append(' *')
+	lines.append(' * Generated by Tools/sdefstubs.py for: %s' % ', '.join(members))
+	lines.append(' * Do not edit; run the generator again instead.')
+	lines.append(' */')
+	lines.append('')
+	lines.append('#import "SPSAppleEvents.h"')
+	lines.append('')
+	lines.append('')
+	lines.append('enum {')
+	for className, code in classes:
+		lines.append("\t%s%sClass = '%s'," % (prefix, identifier(className), code))
+	for className, propertyName, code, description in properties:
+		lines.append("\t%s%s%sProperty = '%s'," % (prefix, identifier(className), identifier(propertyName), code))
+	lines.append('};')
+	
+	for className, propertyName, code, description in properties:
+		name = '%s%s%s' % (prefix, identifier(className), identifier(propertyName))
+		lines.append('')
+		lines.append('')
+		lines.append('/**')
+		lines.append(' * Returns a specifier for the "%s" property of the given %s.' % (propertyName, className))
+		if description:
+			lines.append(' *')
+			lines.append(' * %s.' % (description[0].upper() + description[1:].rstrip('.')))
+		lines.append(' */')
+		lines.append('static inline NSAppleEventDescriptor *%sSpecifier(NSAppleEventDescriptor *%s) {' % (name, identifier(className)[0].lower() + identifier(className)[1:]))
+		lines.append('\treturn SPSPropertySpecifier(%sProperty, %s);' % (name, identifier(className)[0].lower() + identifier(className)[1:]))
+		lines.append('}')
+	
+	return '\n'.join(lines) + '\n'
+
+
+def main(arguments):
+	if len(arguments) < 3:
+		raise SystemExit('usage: %s prefix output.h class.member [...] < dictionary.sdef' % os.path.basename(sys.argv[0]))
+	
+	prefix, outputName, members = arguments[0], arguments[1], arguments[2:]
+	dictionary = Dictionary(xml.dom.minidom.parse(sys.stdin))
+	header = generate(dictionary, prefix, outputName, members)
+	
+	# Leave the file alone if nothing changed, so that it does not cause a rebuild
+	if os.path.exists(outputName) and open(outputName).read() == header:
+		return
+	output = open(outputName, 'w')
+	output.write(header)
+	output.close()
+
+
+if __name__ == '__main__':
+	main(sys.argv[1:])
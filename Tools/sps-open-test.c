@@ -0,0 +1,194 @@
+//
+//  sps-open-test.c
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/*
+ * Tries the framing of SPSOpenProtocol.c: frames that arrive whole, in pieces or all at once, and frames that are malformed. Prints a line per check and exits with 1 if any failed.
+ *
+ * Build and run with:
+ *
+ *     cc -I Sources -o sps-open-test Tools/sps-open-test.c Sources/SPSOpenProtocol.c && ./sps-open-test
+ */
+
+#include "SPSOpenProtocol.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * The number of checks that failed so far.
+ */
+static int SPSOpenTestFailureCount = 0;
+
+
+/**
+ * Prints the outcome of a check and counts it if it failed.
+ */
+static void SPSOpenTestCheck(int passed, const char *description) {
+	printf("%s %s\n", passed ? "ok" : "FAIL", description);
+	if (!passed) {
+		SPSOpenTestFailureCount++;
+	}
+}
+
+/**
+ * Writes a frame with the given payload, returning the number of bytes written.
+ */
+static size_t SPSOpenTestEncodeFrame(const char *payload, uint8_t *bytes) {
+	size_t length = strlen(payload);
+	SPSOpenEncodeLength((uint32_t)length, bytes);
+	memcpy(bytes + 4, payload, length);
+	return 4 + length;
+}
+
+/**
+ * Returns whether a frame taken from a decoder holds the given payload.
+ */
+static int SPSOpenTestFrameEquals(const uint8_t *payload, uint32_t length, const char *expectedPayload) {
+	return length == strlen(expectedPayload) && memcmp(payload, expectedPayload, length) == 0;
+}
+
+/**
+ * A batch of two URLs appended at once comes out as two frames and the empty frame that ends it.
+ */
+static void SPSOpenTestWholeBatch(void) {
+	uint8_t bytes[256];
+	size_t count = 0;
+	count += SPSOpenTestEncodeFrame("http://example.com/", bytes + count);
+	count += SPSOpenTestEncodeFrame("http://example.org/a?b=c", bytes + count);
+	count += SPSOpenTestEncodeFrame("", bytes + count);
+	
+	SPSOpenDecoder decoder;
+	SPSOpenDecoderInit(&decoder);
+	SPSOpenTestCheck(SPSOpenDecoderAppend(&decoder, bytes, count) == 0, "a batch is appended");
+	
+	const uint8_t *payload;
+	uint32_t length;
+	SPSOpenTestCheck(SPSOpenDecoderNextFrame(&decoder, &payload, &length) == 1 && SPSOpenTestFrameEquals(payload, length, "http://example.com/"), "the first URL is taken");
+	SPSOpenTestCheck(SPSOpenDecoderNextFrame(&decoder, &payload, &length) == 1 && SPSOpenTestFrameEquals(payload, length, "http://example.org/a?b=c"), "the second URL is taken");
+	SPSOpenTestCheck(SPSOpenDecoderNextFrame(&decoder, &payload, &length) == 1 && length == 0, "the batch ends with an empty frame");
+	SPSOpenTestCheck(SPSOpenDecoderNextFrame(&decoder, &payload, &length) == 0, "nothing is left after the batch");
+	
+	SPSOpenDecoderDestroy(&decoder);
+}
+
+/**
+ * Frames that arrive a byte at a time only come out once they are complete, including a length prefix that is split.
+ */
+static void SPSOpenTestPartialReads(void) {
+	uint8_t bytes[256];
+	size_t count = 0;
+	count += SPSOpenTestEncodeFrame("http://example.com/one", bytes + count);
+	count += SPSOpenTestEncodeFrame("http://example.com/two", bytes + count);
+	
+	SPSOpenDecoder decoder;
+	SPSOpenDecoderInit(&decoder);
+	
+	const uint8_t *payload;
+	uint32_t length;
+	int frameCount = 0;
+	int earlyFrame = 0;
+	int secondFrameMatches = 0;
+	for (size_t index = 0; index < count; index++) {
+		SPSOpenDecoderAppend(&decoder, bytes + index, 1);
+		
+		int status;
+		while ((status = SPSOpenDecoderNextFrame(&decoder, &payload, &length)) == 1) {
+			frameCount++;
+			if (frameCount == 1 && index != 4 + strlen("http://example.com/one") - 1) {
+				earlyFrame = 1;
+			}
+			if (frameCount == 2) {
+				secondFrameMatches = SPSOpenTestFrameEquals(payload, length, "http://example.com/two");
+			}
+		}
+	}
+	
+	SPSOpenTestCheck(frameCount == 2 && !earlyFrame, "frames read a byte at a time come out when their last byte arrives");
+	SPSOpenTestCheck(secondFrameMatches, "a frame that was moved to the front of the buffer is intact");
+	
+	SPSOpenDecoderDestroy(&decoder);
+}
+
+/**
+ * A payload larger than the initial buffer makes the decoder grow, and one larger than a frame may be is refused.
+ */
+static void SPSOpenTestFrameLengths(void) {
+	SPSOpenDecoder decoder;
+	const uint8_t *payload;
+	uint32_t length;
+	
+	// The largest frame that is allowed, which does not fit the first buffer
+	uint8_t *largeFrame = malloc(4 + SPS_OPEN_MAXIMUM_FRAME_LENGTH);
+	SPSOpenEncodeLength(SPS_OPEN_MAXIMUM_FRAME_LENGTH, largeFrame);
+	memset(largeFrame + 4, 'a', SPS_OPEN_MAXIMUM_FRAME_LENGTH);
+	
+	SPSOpenDecoderInit(&decoder);
+	SPSOpenDecoderAppend(&decoder, largeFrame, 4 + SPS_OPEN_MAXIMUM_FRAME_LENGTH - 1);
+	SPSOpenTestCheck(SPSOpenDecoderNextFrame(&decoder, &payload, &length) == 0, "a frame of the largest length waits for its last byte");
+	SPSOpenDecoderAppend(&decoder, largeFrame + 4 + SPS_OPEN_MAXIMUM_FRAME_LENGTH - 1, 1);
+	SPSOpenTestCheck(SPSOpenDecoderNextFrame(&decoder, &payload, &length) == 1 && length == SPS_OPEN_MAXIMUM_FRAME_LENGTH, "a frame of the largest length is taken");
+	SPSOpenDecoderDestroy(&decoder);
+	free(largeFrame);
+	
+	// Only the prefix of an oversize frame is needed to refuse it
+	uint8_t prefix[4];
+	SPSOpenEncodeLength(SPS_OPEN_MAXIMUM_FRAME_LENGTH + 1, prefix);
+	SPSOpenDecoderInit(&decoder);
+	SPSOpenDecoderAppend(&decoder, prefix, sizeof(prefix));
+	SPSOpenTestCheck(SPSOpenDecoderNextFrame(&decoder, &payload, &length) == -1, "a frame over the largest length is malformed");
+	SPSOpenDecoderDestroy(&decoder);
+	
+	SPSOpenEncodeLength(UINT32_MAX, prefix);
+	SPSOpenDecoderInit(&decoder);
+	SPSOpenDecoderAppend(&decoder, prefix, sizeof(prefix));
+	SPSOpenTestCheck(SPSOpenDecoderNextFrame(&decoder, &payload, &length) == -1, "a length that would overflow is malformed");
+	SPSOpenDecoderDestroy(&decoder);
+}
+
+/**
+ * Acknowledgements keep their counts, and frames of another length are not taken for one.
+ */
+static void SPSOpenTestAcknowledgements(void) {
+	uint8_t frame[4 + SPS_OPEN_ACKNOWLEDGEMENT_LENGTH];
+	SPSOpenEncodeAcknowledgement(70000, 3, frame);
+	
+	SPSOpenDecoder decoder;
+	SPSOpenDecoderInit(&decoder);
+	SPSOpenDecoderAppend(&decoder, frame, sizeof(frame));
+	
+	const uint8_t *payload;
+	uint32_t length;
+	uint32_t openedCount = 0, failedCount = 0;
+	SPSOpenTestCheck(SPSOpenDecoderNextFrame(&decoder, &payload, &length) == 1 && SPSOpenDecodeAcknowledgement(payload, length, &openedCount, &failedCount) == 0 && openedCount == 70000 && failedCount == 3, "an acknowledgement keeps its counts");
+	SPSOpenTestCheck(SPSOpenDecodeAcknowledgement(payload, length - 1, &openedCount, &failedCount) == -1, "a short acknowledgement is refused");
+	
+	SPSOpenDecoderDestroy(&decoder);
+}
+
+int main(void) {
+	SPSOpenTestWholeBatch();
+	SPSOpenTestPartialReads();
+	SPSOpenTestFrameLengths();
+	SPSOpenTestAcknowledgements();
+	
+	return (SPSOpenTestFailureCount > 0) ? 1 : 0;
+}
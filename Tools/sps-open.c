@@ -0,0 +1,289 @@
+//
+//  sps-open.c
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/*
+ * Opens URLs through a running Spatial Safari, without going through Launch Services and a GetURL event for each of them.
+ *
+ * The URLs are taken from the arguments, or else from standard input, one per line. They are streamed to the agent in batches, which it opens like URLs from Apple Events. The exit status is 0 if every URL was opened, 1 if some failed and 2 if the agent could not be reached.
+ *
+ * Usage: sps-open [-s socket] [-b batch-size] [URL ...]
+ *
+ * The socket can also be given with SPS_OPEN_SOCKET. Build with:
+ *
+ *     cc -O2 -I Sources -o sps-open Tools/sps-open.c Sources/SPSOpenProtocol.c
+ */
+
+#include "SPSOpenProtocol.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+/**
+ * The folder of the agent's socket, relative to the home folder.
+ */
+#define SPS_OPEN_SOCKET_FOLDER "Library/Caches/net.naquah.Spatial-Safari"
+
+/**
+ * The number of URLs in a batch, unless given otherwise.
+ */
+#define SPS_OPEN_DEFAULT_BATCH_SIZE 256
+
+
+/**
+ * A connection to the agent and the acknowledgements that are still to come.
+ */
+typedef struct {
+	int socketDescriptor;
+	SPSOpenDecoder decoder;
+	unsigned int outstandingBatchCount;
+	unsigned long openedCount;
+	unsigned long failedCount;
+} SPSOpenClient;
+
+
+/**
+ * Writes all of the given bytes.
+ *
+ * @return 0 on success, or -1 on error.
+ */
+static int SPSOpenWriteAll(int descriptor, const uint8_t *bytes, size_t count) {
+	while (count > 0) {
+		ssize_t written = write(descriptor, bytes, count);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -1;
+		}
+		bytes += written;
+		count -= (size_t)written;
+	}
+	return 0;
+}
+
+/**
+ * Waits for the acknowledgement of the oldest outstanding batch and counts its URLs.
+ *
+ * @return 0 on success, or -1 if the connection was lost or the agent sent something else.
+ */
+static int SPSOpenReadAcknowledgement(SPSOpenClient *client) {
+	const uint8_t *payload;
+	uint32_t length;
+	int status;
+	
+	while ((status = SPSOpenDecoderNextFrame(&client->decoder, &payload, &length)) == 0) {
+		uint8_t bytes[256];
+		ssize_t count = read(client->socketDescriptor, bytes, sizeof(bytes));
+		if (count < 0 && errno == EINTR) {
+			continue;
+		}
+		if (count <= 0 || SPSOpenDecoderAppend(&client->decoder, bytes, (size_t)count) != 0) {
+			return -1;
+		}
+	}
+	
+	uint32_t openedCount, failedCount;
+	if (status < 0 || SPSOpenDecodeAcknowledgement(payload, length, &openedCount, &failedCount) != 0) {
+		return -1;
+	}
+	
+	client->openedCount += openedCount;
+	client->failedCount += failedCount;
+	client->outstandingBatchCount--;
+	return 0;
+}
+
+/**
+ * Sends a batch, which is ended by an empty frame, and keeps the number of outstanding batches within bounds.
+ *
+ * @return 0 on success, or -1 if the connection was lost.
+ */
+static int SPSOpenSendBatch(SPSOpenClient *client, uint8_t *batch, size_t *batchLength) {
+	SPSOpenEncodeLength(0, batch + *batchLength);
+	*batchLength += 4;
+	
+	if (SPSOpenWriteAll(client->socketDescriptor, batch, *batchLength) != 0) {
+		return -1;
+	}
+	*batchLength = 0;
+	client->outstandingBatchCount++;
+	
+	// Keep sending while earlier batches are being opened, but not so far ahead that both sides end up waiting to write
+	if (client->outstandingBatchCount >= SPS_OPEN_MAXIMUM_OUTSTANDING_BATCHES) {
+		return SPSOpenReadAcknowledgement(client);
+	}
+	return 0;
+}
+
+/**
+ * Returns the path of the socket, which is owned by the caller, or NULL if there is none.
+ */
+static char *SPSOpenSocketPath(const char *option) {
+	const char *path = (option != NULL) ? option : getenv("SPS_OPEN_SOCKET");
+	if (path != NULL) {
+		return strdup(path);
+	}
+	
+	const char *home = getenv("HOME");
+	if (home == NULL) {
+		return NULL;
+	}
+	
+	size_t length = strlen(home) + strlen(SPS_OPEN_SOCKET_FOLDER) + strlen(SPS_OPEN_SOCKET_NAME) + 3;
+	char *defaultPath = malloc(length);
+	if (defaultPath != NULL) {
+		snprintf(defaultPath, length, "%s/%s/%s", home, SPS_OPEN_SOCKET_FOLDER, SPS_OPEN_SOCKET_NAME);
+	}
+	return defaultPath;
+}
+
+int main(int argc, char *argv[]) {
+	const char *socketOption = NULL;
+	unsigned long batchSize = SPS_OPEN_DEFAULT_BATCH_SIZE;
+	int option;
+	
+	while ((option = getopt(argc, argv, "s:b:")) != -1) {
+		if (option == 's') {
+			socketOption = optarg;
+		}
+		else if (option == 'b' && strtoul(optarg, NULL, 10) > 0) {
+			batchSize = strtoul(optarg, NULL, 10);
+		}
+		else {
+			fprintf(stderr, "usage: sps-open [-s socket] [-b batch-size] [URL ...]\n");
+			return 2;
+		}
+	}
+	
+	// A lost connection should show up as an error from write, not end the process
+	signal(SIGPIPE, SIG_IGN);
+	
+	char *path = SPSOpenSocketPath(socketOption);
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (path == NULL || strlen(path) >= sizeof(address.sun_path)) {
+		fprintf(stderr, "sps-open: no usable socket path\n");
+		return 2;
+	}
+	strcpy(address.sun_path, path);
+	
+	SPSOpenClient client;
+	memset(&client, 0, sizeof(client));
+	SPSOpenDecoderInit(&client.decoder);
+	client.socketDescriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (client.socketDescriptor == -1 || connect(client.socketDescriptor, (struct sockaddr *)&address, sizeof(address)) != 0) {
+		fprintf(stderr, "sps-open: cannot connect to %s: %s\n", path, strerror(errno));
+		return 2;
+	}
+	
+	// A batch is written at once, with room for the frame that ends it
+	size_t batchCapacity = SPS_OPEN_DEFAULT_BATCH_SIZE * 128;
+	uint8_t *batch = malloc(batchCapacity);
+	size_t batchLength = 0;
+	unsigned long batchCount = 0;
+	char *line = malloc(SPS_OPEN_MAXIMUM_FRAME_LENGTH + 2);
+	int argumentIndex = optind;
+	int failed = (batch == NULL || line == NULL);
+	
+	while (!failed) {
+		const char *URL;
+		if (optind < argc) {
+			if (argumentIndex >= argc) {
+				break;
+			}
+			URL = argv[argumentIndex++];
+		}
+		else {
+			if (fgets(line, SPS_OPEN_MAXIMUM_FRAME_LENGTH + 2, stdin) == NULL) {
+				break;
+			}
+			
+			// A line that did not fit is too long anyway, but what is left of it should not be taken for the next URL
+			if (line[strcspn(line, "\n")] != '\n') {
+				int character;
+				while ((character = getchar()) != EOF && character != '\n') {
+				}
+			}
+			line[strcspn(line, "\r\n")] = '\0';
+			URL = line;
+		}
+		
+		size_t length = strlen(URL);
+		if (length == 0) {
+			continue;
+		}
+		if (length > SPS_OPEN_MAXIMUM_FRAME_LENGTH) {
+			fprintf(stderr, "sps-open: skipping a URL of %lu bytes\n", (unsigned long)length);
+			client.failedCount++;
+			continue;
+		}
+		
+		if (batchLength + 4 + length + 4 > batchCapacity) {
+			uint8_t *grownBatch = realloc(batch, batchLength + 4 + length + 4);
+			if (grownBatch == NULL) {
+				failed = 1;
+				break;
+			}
+			batch = grownBatch;
+			batchCapacity = batchLength + 4 + length + 4;
+		}
+		SPSOpenEncodeLength((uint32_t)length, batch + batchLength);
+		memcpy(batch + batchLength + 4, URL, length);
+		batchLength += 4 + length;
+		
+		if (++batchCount == batchSize) {
+			failed = (SPSOpenSendBatch(&client, batch, &batchLength) != 0);
+			batchCount = 0;
+		}
+	}
+	
+	if (!failed && batchCount > 0) {
+		failed = (SPSOpenSendBatch(&client, batch, &batchLength) != 0);
+	}
+	while (!failed && client.outstandingBatchCount > 0) {
+		failed = (SPSOpenReadAcknowledgement(&client) != 0);
+	}
+	
+	close(client.socketDescriptor);
+	SPSOpenDecoderDestroy(&client.decoder);
+	free(batch);
+	free(line);
+	
+	if (failed) {
+		fprintf(stderr, "sps-open: lost the connection to %s\n", path);
+		free(path);
+		return 2;
+	}
+	free(path);
+	
+	if (client.failedCount > 0) {
+		fprintf(stderr, "sps-open: %lu of %lu URLs could not be opened\n", client.failedCount, client.openedCount + client.failedCount);
+		return 1;
+	}
+	return 0;
+}
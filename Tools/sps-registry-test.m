@@ -0,0 +1,183 @@
+//
+//  sps-registry-test.m
+//  Spatial Safari
+//
+//  Created by agent on 17-10-2026.
+//  Copyright 2026 agent.
+//  
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//  
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+/*
+ * Drives SPSProcessRegistry from a fake process table: the processes it finds at the start, launches and terminations, several processes of one application, reused process identifiers and reloading. Prints a line per check and exits with 1 if any failed.
+ *
+ * Only Foundation is needed, so the test also runs headless, away from any window server. Build and run on Mac OS X with:
+ *
+ *     cc -framework Foundation -I Sources -o sps-registry-test Tools/sps-registry-test.m Sources/SPSProcessRegistry.m Sources/SPSFakeProcessTable.m && ./sps-registry-test
+ *
+ * or on Linux, with GNUstep Base and the blocks runtime:
+ *
+ *     clang -fblocks `gnustep-config --objc-flags` -I Sources -o sps-registry-test Tools/sps-registry-test.m Sources/SPSProcessRegistry.m Sources/SPSFakeProcessTable.m `gnustep-config --base-libs` -lBlocksRuntime && ./sps-registry-test
+ */
+
+#import <Foundation/Foundation.h>
+#import "SPSProcessRegistry.h"
+#import "SPSFakeProcessTable.h"
+
+
+#define SPS_TEST_SAFARI @"com.apple.Safari"
+#define SPS_TEST_FINDER @"com.apple.finder"
+
+
+/**
+ * The number of checks that failed so far.
+ */
+static int SPSRegistryTestFailureCount = 0;
+
+
+/**
+ * Prints the outcome of a check and counts it if it failed.
+ */
+static void SPSRegistryTestCheck(BOOL passed, const char *description) {
+	printf("%s %s\n", passed ? "ok" : "FAIL", description);
+	if (!passed) {
+		SPSRegistryTestFailureCount++;
+	}
+}
+
+/**
+ * The processes that are running when the registry is made are found, and the table reports to the registry from then on.
+ */
+static void SPSRegistryTestInitialProcesses(void) {
+	SPSFakeProcessTable *processTable = [[SPSFakeProcessTable alloc] init];
+	[processTable launchProcessWithIdentifier:100 bundleIdentifier:SPS_TEST_SAFARI];
+	[processTable launchProcessWithIdentifier:200 bundleIdentifier:SPS_TEST_FINDER];
+	
+	SPSProcessRegistry *registry = [[SPSProcessRegistry alloc] initWithBackend:processTable];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 100, "a process that was running at the start is found");
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_FINDER] == 200, "every process that was running at the start is found");
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:@"com.example.Missing"] == 0, "an application that is not running is not found");
+	SPSRegistryTestCheck([processTable delegate] == registry, "the registry listens to its backend");
+	
+	[registry release];
+	SPSRegistryTestCheck([processTable delegate] == nil, "a registry that is let go of stops listening to its backend");
+	[processTable release];
+}
+
+/**
+ * Launches and terminations are followed as the backend reports them.
+ */
+static void SPSRegistryTestLaunchAndTermination(void) {
+	SPSFakeProcessTable *processTable = [[SPSFakeProcessTable alloc] init];
+	SPSProcessRegistry *registry = [[SPSProcessRegistry alloc] initWithBackend:processTable];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 0, "nothing is found in an empty table");
+	
+	[processTable launchProcessWithIdentifier:100 bundleIdentifier:SPS_TEST_SAFARI];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 100, "a launched process is found");
+	
+	[processTable terminateProcessWithIdentifier:100];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 0, "a terminated process is no longer found");
+	
+	[processTable launchProcessWithIdentifier:101 bundleIdentifier:SPS_TEST_SAFARI];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 101, "a relaunched process is found by its new identifier");
+	
+	[registry release];
+	[processTable release];
+}
+
+/**
+ * Of several processes of one application the most recently launched one is found, and the one before it once that one terminates.
+ */
+static void SPSRegistryTestSeveralProcesses(void) {
+	SPSFakeProcessTable *processTable = [[SPSFakeProcessTable alloc] init];
+	SPSProcessRegistry *registry = [[SPSProcessRegistry alloc] initWithBackend:processTable];
+	
+	[processTable launchProcessWithIdentifier:100 bundleIdentifier:SPS_TEST_SAFARI];
+	[processTable launchProcessWithIdentifier:101 bundleIdentifier:SPS_TEST_SAFARI];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 101, "the most recently launched process is found");
+	
+	[processTable terminateProcessWithIdentifier:101];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 100, "the earlier process is found once the later one terminates");
+	
+	[processTable launchProcessWithIdentifier:102 bundleIdentifier:SPS_TEST_SAFARI];
+	[processTable terminateProcessWithIdentifier:100];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 102, "terminating an earlier process leaves the later one");
+	
+	[registry release];
+	[processTable release];
+}
+
+/**
+ * A process identifier that is reused belongs to the new process only.
+ */
+static void SPSRegistryTestReusedIdentifier(void) {
+	SPSFakeProcessTable *processTable = [[SPSFakeProcessTable alloc] init];
+	SPSProcessRegistry *registry = [[SPSProcessRegistry alloc] initWithBackend:processTable];
+	
+	// The termination of the old process has not been reported when its identifier is reused
+	[processTable launchProcessWithIdentifier:100 bundleIdentifier:SPS_TEST_SAFARI];
+	[processTable setDelegate:nil];
+	[processTable terminateProcessWithIdentifier:100];
+	[processTable setDelegate:registry];
+	[processTable launchProcessWithIdentifier:100 bundleIdentifier:SPS_TEST_FINDER];
+	
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_FINDER] == 100, "a reused identifier is found for the new process");
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 0, "a reused identifier is no longer found for the old process");
+	
+	[processTable terminateProcessWithIdentifier:100];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_FINDER] == 0, "the new process is gone once it terminates");
+	
+	[registry release];
+	[processTable release];
+}
+
+/**
+ * Processes can be forgotten before the backend reports them terminated, and reloading asks the backend again.
+ */
+static void SPSRegistryTestRemovalAndReload(void) {
+	SPSFakeProcessTable *processTable = [[SPSFakeProcessTable alloc] init];
+	[processTable launchProcessWithIdentifier:100 bundleIdentifier:SPS_TEST_SAFARI];
+	SPSProcessRegistry *registry = [[SPSProcessRegistry alloc] initWithBackend:processTable];
+	
+	[registry removeProcessWithIdentifier:100];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 0, "a removed process is no longer found");
+	
+	[registry removeProcessWithIdentifier:999];
+	[processTable terminateProcessWithIdentifier:100];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 0, "removing an unknown process and a late termination change nothing");
+	
+	// Launches that were missed are picked up by reloading
+	[processTable setDelegate:nil];
+	[processTable launchProcessWithIdentifier:101 bundleIdentifier:SPS_TEST_SAFARI];
+	[processTable setDelegate:registry];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 0, "a launch that was not reported is not found");
+	
+	[registry reload];
+	SPSRegistryTestCheck([registry processIdentifierForBundleIdentifier:SPS_TEST_SAFARI] == 101, "a launch that was not reported is found after reloading");
+	
+	[registry release];
+	[processTable release];
+}
+
+int main(void) {
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+	
+	SPSRegistryTestInitialProcesses();
+	SPSRegistryTestLaunchAndTermination();
+	SPSRegistryTestSeveralProcesses();
+	SPSRegistryTestReusedIdentifier();
+	SPSRegistryTestRemovalAndReload();
+	
+	[pool drain];
+	return (SPSRegistryTestFailureCount > 0) ? 1 : 0;
+}